@@ -0,0 +1,107 @@
+#ifndef LIBSNAKE_H
+#define LIBSNAKE_H
+
+/*
+ * C API of libsnake, the headless game core as a shared library. No SDL types cross it and nothing
+ * throws: failures come back as NULL, 0 or -1. A snake_game is not thread safe, but separate games can
+ * be driven from separate threads.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* The library itself is built with SNAKE_BUILD defined; its users import the functions. */
+#if defined(_WIN32) && defined(SNAKE_BUILD)
+#define SNAKE_API __declspec(dllexport)
+#elif defined(_WIN32)
+#define SNAKE_API __declspec(dllimport)
+#else
+#define SNAKE_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Bumped whenever a function or enum changes incompatibly. */
+#define SNAKE_API_VERSION 1
+
+typedef struct snake_game snake_game;
+
+enum snake_direction
+{
+	SNAKE_LEFT = 0,
+	SNAKE_RIGHT = 1,
+	SNAKE_UP = 2,
+	SNAKE_DOWN = 3
+};
+
+enum snake_step_result
+{
+	SNAKE_MOVED = 0,
+	SNAKE_ATE_FOOD = 1,
+	SNAKE_COLLIDED = 2,
+	SNAKE_WON = 3
+};
+
+enum snake_autopilot
+{
+	SNAKE_AUTOPILOT_A_STAR = 0,
+	SNAKE_AUTOPILOT_HAMILTONIAN = 1,
+	SNAKE_AUTOPILOT_DISTANCE_FIELD = 2,
+	SNAKE_AUTOPILOT_MONTE_CARLO = 3
+};
+
+SNAKE_API uint32_t snake_api_version(void);
+
+/* Returns NULL if the board is empty, has more than INT_MAX cells or memory runs out. */
+SNAKE_API snake_game* snake_create(int columns, int rows, uint64_t seed);
+
+SNAKE_API void snake_destroy(snake_game* game);
+
+SNAKE_API void snake_reset(snake_game* game);
+
+/* Returns a snake_step_result, or -1 for a bad direction or if memory runs out. Turning back onto the neck is ignored. */
+SNAKE_API int snake_step(snake_game* game, int direction);
+
+/* Selects the engine behind snake_autopilot_direction. Returns 0 for an unknown autopilot. */
+SNAKE_API int snake_set_autopilot(snake_game* game, int autopilot, int wrapped);
+
+/* The direction the selected autopilot would take next, or -1 if memory runs out; pass it to snake_step. */
+SNAKE_API int snake_autopilot_direction(snake_game* game);
+
+SNAKE_API int snake_columns(const snake_game* game);
+
+SNAKE_API int snake_rows(const snake_game* game);
+
+SNAKE_API int snake_score(const snake_game* game);
+
+SNAKE_API uint64_t snake_steps(const snake_game* game);
+
+SNAKE_API int snake_game_over(const snake_game* game);
+
+SNAKE_API int snake_won(const snake_game* game);
+
+SNAKE_API int snake_direction(const snake_game* game);
+
+/* Grid index (y * columns + x) of the food, or -1 once the board is full. */
+SNAKE_API int snake_food(const snake_game* game);
+
+SNAKE_API size_t snake_length(const snake_game* game);
+
+/* Copies up to capacity grid indices of the body, head first, and returns the full length. */
+SNAKE_API size_t snake_body(const snake_game* game, int* cells, size_t capacity);
+
+/* Writes a snapshot of the whole game into buffer if it fits and returns its size either way, so a first
+   call with capacity 0 asks for the size. Returns 0 if memory runs out. */
+SNAKE_API size_t snake_snapshot(snake_game* game, uint8_t* buffer, size_t capacity);
+
+/* Restores a snapshot of a game on a board of the same size. Returns 0 and leaves the game untouched on failure. */
+SNAKE_API int snake_restore(snake_game* game, const uint8_t* data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
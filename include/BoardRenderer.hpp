@@ -0,0 +1,93 @@
+#ifndef BOARD_RENDERER_HPP
+#define BOARD_RENDERER_HPP
+
+#include <SDL2/SDL.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+enum class CellColour : std::uint8_t
+{
+	EMPTY, 
+	PATH, 
+	BODY, 
+	HEAD, 
+	FOOD, 
+	COUNT
+};
+
+// Keeps the board in a persistent target texture. Cells are recoloured through SetCell and only the
+// cells whose colour actually changed are redrawn on Flush, batched into one SDL_RenderFillRects
+// call per colour.
+class BoardRenderer
+{
+private:
+	static constexpr std::size_t colour_count = static_cast<std::size_t>(CellColour::COUNT);
+
+	int columns_;
+	int rows_;
+	int cell_side_;
+	bool full_redraw_;
+
+	SDL_Texture* texture_;
+
+	std::vector<CellColour> pending_;
+	std::vector<CellColour> drawn_;
+	std::vector<std::uint8_t> dirty_;
+	std::vector<int> dirty_cells_;
+	std::array<std::vector<SDL_Rect>, colour_count> batches_;
+
+	SDL_Rect CellRect(int index) const;
+
+	void DrawBatches(SDL_Renderer* renderer);
+
+public:
+	BoardRenderer();
+
+	~BoardRenderer();
+
+	BoardRenderer(const BoardRenderer&) = delete;
+
+	BoardRenderer& operator=(const BoardRenderer&) = delete;
+
+	// Returns false if the target texture could not be created (e.g. a board larger than the renderer supports);
+	// the board is then drawn directly, all non-empty cells every frame.
+	bool Initialize(SDL_Renderer* renderer, int columns, int rows, int cell_side);
+
+	void Free();
+
+	// Creates the texture again after the renderer lost it (SDL_RENDER_DEVICE_RESET or SDL_RENDER_TARGETS_RESET).
+	// The cell colours are kept and the whole texture is repainted on the next Flush.
+	bool RecreateTexture(SDL_Renderer* renderer);
+
+	// Sets every cell to EMPTY and repaints the whole texture on the next Flush.
+	void Clear();
+
+	// Repaints the whole texture from the current cell colours, e.g. after the render targets were reset.
+	void Invalidate();
+
+	CellColour Cell(int index) const
+	{
+		return pending_[index];
+	}
+
+	void SetCell(int index, CellColour colour)
+	{
+		pending_[index] = colour;
+
+		if (!dirty_[index])
+		{
+			dirty_[index] = 1;
+			dirty_cells_.push_back(index);
+		}
+	}
+
+	// Draws the changed cells into the texture.
+	void Flush(SDL_Renderer* renderer);
+
+	// Copies the board to the current render target with its top left corner at (x, y).
+	void Render(SDL_Renderer* renderer, int x, int y);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,122 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include "Core/Direction.hpp"
+#include "Core/Grid.hpp"
+#include "Utils/WorkStealingPool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Many AI snakes on one shared wrapped board. Snake state lives in parallel arrays indexed by snake, and
+// every body is a fixed-capacity ring buffer inside one contiguous array, so a tick streams through memory
+// instead of chasing objects.
+//
+// A tick runs in phases over chunks of snakes on a thread pool. Every snake picks a free or food cell next
+// to its head from the board as it was at the start of the tick and claims it; snakes that share a claim,
+// or have nowhere to go, die and leave food behind. Each phase only reads the state of earlier phases and
+// writes cells and slots no other snake writes, and each snake draws from its own random stream, so the
+// result is the same for any number of threads. Food and new snakes are placed afterwards on one thread.
+class Arena
+{
+private:
+	enum class Fate : std::uint8_t
+	{
+		MOVE, EAT, DIE
+	};
+
+	static constexpr std::int32_t empty_cell = -1;
+	static constexpr std::int32_t food_cell = -2;
+
+	Grid grid_;
+	std::size_t capacity_;
+	std::size_t spawn_length_;
+	std::size_t food_target_;
+
+	// Per cell: the snake on it, or empty_cell / food_cell. claims_ counts the heads heading into the cell.
+	std::vector<std::int32_t> cells_;
+	std::unique_ptr<std::atomic<std::uint8_t>[]> claims_;
+
+	// Per snake. Snake i's body is body_[i * capacity_ ...], head at head_slot_[i], going backwards.
+	std::vector<int> body_;
+	std::vector<std::uint32_t> head_slot_;
+	std::vector<std::uint32_t> length_;
+	std::vector<Direction> direction_;
+	std::vector<int> target_;
+	std::vector<Fate> fate_;
+	std::vector<std::uint8_t> alive_;
+	std::vector<std::uint64_t> rng_;
+
+	// Per chunk of snakes, summed after each parallel phase.
+	std::vector<std::size_t> chunk_eaten_;
+	std::vector<std::size_t> chunk_deaths_;
+	std::vector<std::size_t> chunk_food_;
+
+	std::unique_ptr<WorkStealingPool> pool_;
+	std::size_t chunk_size_;
+	std::mt19937_64 mt_;
+
+	std::uint64_t tick_;
+	std::size_t alive_count_;
+	std::size_t food_count_;
+	std::uint64_t deaths_;
+	std::uint64_t food_eaten_;
+
+	template <typename Phase>
+	void ForEachChunk(Phase phase);
+
+	void Decide(std::size_t snake);
+
+	void Resolve(std::size_t snake, std::size_t chunk);
+
+	void Apply(std::size_t snake, std::size_t chunk);
+
+	bool SpawnSnake(std::size_t snake);
+
+	void SpawnFood();
+
+public:
+	// Places snake_count snakes of spawn_length cells and food_count pieces of food. Bodies never grow past
+	// capacity cells.
+	Arena(int columns, int rows, std::size_t snake_count, std::size_t spawn_length, std::size_t capacity, 
+		std::size_t food_count, std::uint64_t seed, std::size_t thread_count = std::thread::hardware_concurrency());
+
+	void Tick();
+
+	const Grid& GetGrid() const;
+
+	std::size_t SnakeCount() const;
+
+	std::size_t AliveCount() const;
+
+	bool Alive(std::size_t snake) const;
+
+	std::size_t Length(std::size_t snake) const;
+
+	// Segment 0 is the head.
+	int Segment(std::size_t snake, std::size_t i) const
+	{
+		return body_[snake * capacity_ + (head_slot_[snake] + capacity_ - i) % capacity_];
+	}
+
+	// The snake on the cell, or -1 if there is none.
+	int Owner(int index) const;
+
+	bool IsFood(int index) const;
+
+	std::uint64_t Ticks() const;
+
+	std::uint64_t Deaths() const;
+
+	std::uint64_t FoodEaten() const;
+
+	// Hash of the board and every snake, to compare runs with different thread counts.
+	std::uint64_t Checksum() const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef BITBOARD_HPP
+#define BITBOARD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// One bit per grid cell, indexed by grid index and packed 64 cells to a word.
+class Bitboard
+{
+private:
+	std::size_t size_;
+	std::vector<std::uint64_t> words_;
+
+public:
+	explicit Bitboard(std::size_t size = 0);
+
+	void Resize(std::size_t size);
+
+	void Clear();
+
+	std::size_t Size() const;
+
+	std::size_t Count() const;
+
+	const std::vector<std::uint64_t>& Words() const;
+
+	std::vector<std::uint64_t>& MutableWords();
+
+	// Sets this board to the cells other does not have, over other's size.
+	void AssignComplement(const Bitboard& other);
+
+	bool Test(int index) const
+	{
+		return (words_[static_cast<std::size_t>(index) >> 6] >> (index & 63)) & 1;
+	}
+
+	void Set(int index)
+	{
+		words_[static_cast<std::size_t>(index) >> 6] |= std::uint64_t{ 1 } << (index & 63);
+	}
+
+	void Reset(int index)
+	{
+		words_[static_cast<std::size_t>(index) >> 6] &= ~(std::uint64_t{ 1 } << (index & 63));
+	}
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,9 @@
+#ifndef DIRECTION_HPP
+#define DIRECTION_HPP
+
+enum class Direction
+{
+	LEFT, RIGHT, UP, DOWN
+};
+
+#endif
\ No newline at end of file
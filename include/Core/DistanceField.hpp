@@ -0,0 +1,51 @@
+#ifndef DISTANCE_FIELD_HPP
+#define DISTANCE_FIELD_HPP
+
+#include "Core/Bitboard.hpp"
+#include "Core/Grid.hpp"
+
+#include <climits>
+#include <cstddef>
+#include <vector>
+
+// Breadth-first distances from one source cell (the food) to every cell reachable around the blocked
+// cells. With unit step costs this is the exact shortest path length, so a walker can reach the source
+// from anywhere by stepping to the neighbour with the smallest distance.
+class DistanceField
+{
+public:
+	static constexpr int unreachable = INT_MAX;
+
+private:
+	std::vector<int> distance_;
+	std::vector<int> queue_;
+	int source_;
+	bool wrapped_;
+
+	void Propagate(const Grid& grid, const Bitboard& blocked);
+
+public:
+	DistanceField();
+
+	// Full breadth-first search from source over the cells that are not blocked.
+	void Compute(const Grid& grid, const Bitboard& blocked, int source, bool wrapped);
+
+	// Patches the field after index stopped being blocked: gives it a distance through its neighbours and
+	// lowers every distance that got shorter through it. Only ever decreases distances.
+	void Release(const Grid& grid, const Bitboard& blocked, int index);
+
+	void Invalidate();
+
+	bool Empty() const;
+
+	int Source() const;
+
+	bool Wrapped() const;
+
+	int Distance(int index) const
+	{
+		return distance_[index];
+	}
+};
+
+#endif
\ No newline at end of file
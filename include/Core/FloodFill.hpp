@@ -0,0 +1,35 @@
+#ifndef FLOOD_FILL_HPP
+#define FLOOD_FILL_HPP
+
+#include "Core/Bitboard.hpp"
+
+#include <cstddef>
+
+// Flood fill over Bitboards laid out row by row on a columns x rows grid, a 64-cell word at a time.
+// Runs along a row are filled with occluded (Kogge-Stone) shifts and carried across word boundaries,
+// and columns are filled with in-place shifts by one row, so a pass covers long straight stretches
+// and the number of passes grows with the number of turns in the region rather than its size.
+class FloodFill
+{
+private:
+	int columns_;
+	int rows_;
+	Bitboard first_column_;
+	Bitboard last_column_;
+
+	bool FillRows(const Bitboard& open, Bitboard& region) const;
+
+	bool FillColumns(const Bitboard& open, Bitboard& region) const;
+
+	bool FillEdges(const Bitboard& open, Bitboard& region) const;
+
+public:
+	FloodFill(int columns = 0, int rows = 0);
+
+	// Grows region (the seeds) through the open cells until nothing changes or, if target_index is not -1,
+	// until the region reaches it. Wrapped fills also cross the board edges. Returns whether target_index
+	// was reached, or true when there is no target.
+	bool Fill(const Bitboard& open, Bitboard& region, bool wrapped, int target_index = -1) const;
+};
+
+#endif
\ No newline at end of file
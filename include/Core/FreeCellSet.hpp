@@ -0,0 +1,45 @@
+#ifndef FREE_CELL_SET_HPP
+#define FREE_CELL_SET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Set of grid indices kept as one bit per cell plus a Fenwick tree of the member count of each 64-bit word, so
+// insert, erase and finding the k-th member are all O(log n). Members are ordered by index whatever the order
+// they were inserted in, so a set rebuilt from the board picks exactly like the one it replaces.
+class FreeCellSet
+{
+private:
+	std::vector<std::uint64_t> words_;
+	// counts_[i] holds the members of the words in (i - (i & -i), i], one based.
+	std::vector<std::uint32_t> counts_;
+	std::size_t tree_words_;
+	std::size_t size_;
+
+	void AddToWord(std::size_t word, int delta);
+
+public:
+	explicit FreeCellSet(std::size_t capacity = 0);
+
+	// Resets the set to contain every index in [0, capacity).
+	void Fill(std::size_t capacity);
+
+	void Insert(int index);
+
+	void Erase(int index);
+
+	bool Contains(int index) const
+	{
+		return (words_[static_cast<std::size_t>(index) >> 6] >> (index & 63)) & 1;
+	}
+
+	bool Empty() const;
+
+	std::size_t Size() const;
+
+	// The member at position in index order.
+	int At(std::size_t position) const;
+};
+
+#endif
\ No newline at end of file
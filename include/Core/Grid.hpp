@@ -0,0 +1,68 @@
+#ifndef GRID_HPP
+#define GRID_HPP
+
+#include "Core/Direction.hpp"
+#include "Core/GridCell.hpp"
+#include "Core/NeighbourTable.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+
+// Board geometry chosen at runtime. Cells are plain row-major grid indices; nothing is stored per cell
+// except the neighbour table's border byte, so very large boards stay cheap.
+class Grid
+{
+private:
+	int columns_;
+	int rows_;
+	NeighbourTable neighbours_;
+
+public:
+	Grid(int columns, int rows);
+
+	int Columns() const;
+
+	int Rows() const;
+
+	std::size_t CellCount() const;
+
+	int ConvertXYToGridIndex(int x, int y) const
+	{
+		return y * columns_ + x;
+	}
+
+	GridCell Cell(int index) const
+	{
+		return GridCell(index % columns_, index / columns_);
+	}
+
+	// Manhattan distance, measured around the edges as well when wrapped is set.
+	int Distance(int from_index, int to_index, bool wrapped) const
+	{
+		const GridCell from_cell = Cell(from_index);
+		const GridCell to_cell = Cell(to_index);
+
+		const int x_distance = std::abs(to_cell.x_ - from_cell.x_);
+		const int y_distance = std::abs(to_cell.y_ - from_cell.y_);
+
+		if (!wrapped)
+		{
+			return x_distance + y_distance;
+		}
+
+		return std::min(x_distance, columns_ - x_distance) + std::min(y_distance, rows_ - y_distance);
+	}
+
+	int Neighbour(int index, Direction direction, bool wrapped) const
+	{
+		return neighbours_.Neighbour(index, direction, wrapped);
+	}
+
+	NeighbourList Neighbours(int index, bool wrapped) const
+	{
+		return neighbours_.Neighbours(index, wrapped);
+	}
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,18 @@
+#ifndef GRID_CELL_HPP
+#define GRID_CELL_HPP
+
+// Column and row of a cell. Cells are identified by grid index everywhere else; Grid::Cell converts.
+class GridCell
+{
+public:
+	int x_;
+	int y_;
+
+	GridCell(int x = 0, int y = 0);
+
+	~GridCell() = default;
+
+	int GetXYDistance(const GridCell& target_cell) const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef HAMILTONIAN_CYCLE_HPP
+#define HAMILTONIAN_CYCLE_HPP
+
+#include <vector>
+
+// A closed tour through every grid cell using only plain (non-wrapping) moves. Built as a serpentine over
+// the rows with column 0 kept free as the way back, or over the columns when the row count is odd.
+class HamiltonianCycle
+{
+private:
+	std::vector<int> order_;
+	std::vector<int> cells_;
+
+public:
+	HamiltonianCycle();
+
+	// A cycle of this shape needs at least a 2x2 grid with an even number of rows or columns.
+	static bool Exists(int columns, int rows);
+
+	bool Build(int columns, int rows);
+
+	bool Empty() const;
+
+	void Reverse();
+
+	// Whether Reverse has been applied an odd number of times since Build.
+	bool Reversed() const;
+
+	int Order(int index) const
+	{
+		return order_[index];
+	}
+
+	int Successor(int index) const
+	{
+		const int next_order = order_[index] + 1;
+
+		return cells_[next_order == static_cast<int>(cells_.size()) ? 0 : next_order];
+	}
+
+	// Number of steps along the cycle from one cell to the other.
+	int Distance(int from_index, int to_index) const
+	{
+		const int distance = order_[to_index] - order_[from_index];
+
+		return distance < 0 ? distance + static_cast<int>(cells_.size()) : distance;
+	}
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,78 @@
+#ifndef INCREMENTAL_PLANNER_HPP
+#define INCREMENTAL_PLANNER_HPP
+
+#include <cstdint>
+#include <queue>
+#include <utility>
+#include <vector>
+
+class Simulation;
+
+// D* Lite search from the food towards the snake head. The search state survives between steps, so after
+// an ordinary move only the cells around the vacated tail and the previous head are repaired instead of
+// searching the whole grid again. A new food cell or a change of topology starts a fresh search.
+class IncrementalPlanner
+{
+private:
+	using Key = std::pair<int, int>;
+
+	struct OpenEntry
+	{
+		Key key_;
+		int index_;
+
+		bool operator>(const OpenEntry& other) const
+		{
+			return key_ > other.key_;
+		}
+	};
+
+	const Simulation* simulation_;
+	bool valid_;
+	bool wrapped_;
+	int start_;
+	int last_start_;
+	int goal_;
+	int key_modifier_;
+	std::uint64_t synced_step_;
+
+	std::vector<int> g_;
+	std::vector<int> rhs_;
+	std::vector<Key> open_keys_;
+	std::vector<bool> in_open_;
+	std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<OpenEntry>> open_;
+
+	std::vector<int> path_;
+
+	void Initialize();
+
+	bool IsBlocked(int index) const;
+
+	int Heuristic(int from_index, int to_index) const;
+
+	Key CalculateKey(int index) const;
+
+	void UpdateVertex(int index);
+
+	void UpdateVertexAndNeighbours(int index);
+
+	bool PopOpen(OpenEntry& entry);
+
+	void ComputeShortestPath();
+
+	bool ExtractPath();
+
+public:
+	IncrementalPlanner();
+
+	void Invalidate();
+
+	// Brings the plan up to date with the simulation's current head and food. Expected to be called after
+	// every step; if a step was missed the search is rebuilt from scratch.
+	bool Plan(const Simulation& simulation, bool wrapped);
+
+	// Cells from the food back to the cell after the head, the same order Simulation::FindAStarPath uses.
+	const std::vector<int>& Path() const;
+};
+
+#endif
\ No newline at end of file
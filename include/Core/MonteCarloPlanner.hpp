@@ -0,0 +1,72 @@
+#ifndef MONTE_CARLO_PLANNER_HPP
+#define MONTE_CARLO_PLANNER_HPP
+
+#include "Core/Direction.hpp"
+#include "Utils/WorkStealingPool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Simulation;
+
+// Scores every safe first move by playing randomised rollouts from it on copies of the game, and picks the move
+// with the best mix of survival and food. Rollouts run on a thread pool; each worker keeps its own Simulation,
+// copies the live game state into it once per decision and takes every rollout's steps back afterwards, so a
+// rollout costs its own steps rather than the board size and does not allocate. Every rollout has its own seed, drawn from
+// the game's RNG without advancing it, so the choice does not depend on the number of threads. With a time
+// budget it also depends on how many rounds fit, so only a rollout budget is reproducible run to run.
+class MonteCarloPlanner
+{
+private:
+	struct Candidate
+	{
+		int index_;
+		Direction direction_;
+	};
+
+	std::unique_ptr<WorkStealingPool> pool_;
+	std::vector<std::unique_ptr<Simulation>> workers_;
+	std::vector<Candidate> candidates_;
+	std::vector<double> values_;
+	// Decision each worker last copied the game state for.
+	std::vector<std::uint64_t> worker_decisions_;
+	std::uint64_t decision_;
+
+	int rollouts_;
+	int depth_;
+	std::int64_t budget_us_;
+	std::uint64_t rollouts_run_;
+
+	void PrepareWorkers(const Simulation& simulation);
+
+	double Rollout(Simulation& simulation, const Candidate& candidate, std::uint64_t seed) const;
+
+public:
+	explicit MonteCarloPlanner(std::size_t thread_count);
+
+	~MonteCarloPlanner();
+
+	MonteCarloPlanner(const MonteCarloPlanner&) = delete;
+
+	MonteCarloPlanner& operator=(const MonteCarloPlanner&) = delete;
+
+	std::size_t ThreadCount() const;
+
+	// Most rollouts played from each candidate move per decision.
+	void SetRollouts(int rollouts);
+
+	// Steps played after the candidate move in each rollout.
+	void SetDepth(int depth);
+
+	// Stops starting new rounds of rollouts once this much time has passed; 0 plays all of them.
+	void SetTimeBudgetUs(std::int64_t budget_us);
+
+	// Rollouts played by the last ChooseDirection call.
+	std::uint64_t RolloutsRun() const;
+
+	Direction ChooseDirection(const Simulation& simulation);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,105 @@
+#ifndef NEIGHBOUR_TABLE_HPP
+#define NEIGHBOUR_TABLE_HPP
+
+#include "Core/Direction.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Up to four neighbour indices held by value, so iterating them never allocates.
+class NeighbourList
+{
+private:
+	std::array<int, 4> indices_;
+	int count_;
+
+public:
+	NeighbourList() : indices_{}, count_(0)
+	{
+	}
+
+	void Add(int index)
+	{
+		indices_[count_++] = index;
+	}
+
+	const int* begin() const
+	{
+		return indices_.data();
+	}
+
+	const int* end() const
+	{
+		return indices_.data() + count_;
+	}
+
+	int Size() const
+	{
+		return count_;
+	}
+};
+
+// Neighbour lookup for the plain and the wrapped (toroidal) grid, built once per grid size. Every cell
+// only stores which borders it touches; the index offsets for each of the 16 border combinations are
+// precomputed, so a lookup is a byte load and an add with no coordinate conversions.
+class NeighbourTable
+{
+private:
+	static constexpr std::uint8_t left_border = 1;
+	static constexpr std::uint8_t right_border = 2;
+	static constexpr std::uint8_t top_border = 4;
+	static constexpr std::uint8_t bottom_border = 8;
+
+	int columns_;
+	int rows_;
+	std::vector<std::uint8_t> borders_;
+	std::array<int, 4> plain_offsets_;
+	std::array<std::uint8_t, 4> direction_borders_;
+	std::array<std::array<int, 4>, 16> wrapped_offsets_;
+
+public:
+	NeighbourTable(int columns = 0, int rows = 0);
+
+	int Columns() const;
+
+	int Rows() const;
+
+	// Grid index next to index in the given direction, or -1 when it would leave a plain grid.
+	int Neighbour(int index, Direction direction, bool wrapped) const
+	{
+		const std::uint8_t borders = borders_[index];
+		const int d = static_cast<int>(direction);
+
+		if (wrapped)
+		{
+			return index + wrapped_offsets_[borders][d];
+		}
+
+		return (borders & direction_borders_[d]) != 0 ? -1 : index + plain_offsets_[d];
+	}
+
+	// Neighbours in Direction order (left, right, up, down), skipping the ones off a plain grid.
+	NeighbourList Neighbours(int index, bool wrapped) const
+	{
+		NeighbourList neighbours;
+		const std::uint8_t borders = borders_[index];
+
+		for (int d = 0; d < 4; ++d)
+		{
+			if (wrapped)
+			{
+				neighbours.Add(index + wrapped_offsets_[borders][d]);
+			}
+			else if ((borders & direction_borders_[d]) == 0)
+			{
+				neighbours.Add(index + plain_offsets_[d]);
+			}
+		}
+
+		return neighbours;
+	}
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,70 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include "Core/Direction.hpp"
+#include "Core/Simulation.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class ReplayEventType : std::uint8_t
+{
+	TURN, 
+	AUTOPILOT, 
+	RESET
+};
+
+// value_ is the Direction of a TURN, or 0 for off and otherwise the AutopilotMode plus one for AUTOPILOT.
+struct ReplayEvent
+{
+	std::uint64_t step_;
+	ReplayEventType type_;
+	std::uint8_t value_;
+};
+
+// Everything needed to replay a session exactly: the board size, the seed, and the events that
+// happened before each Simulation::Step. Turns are recorded whatever produced them, so a replay
+// does not depend on autopilot internals; autopilot toggles are kept for display.
+//
+// File layout, little endian: "SNKR", version byte, columns and rows (u32), seed, step count and
+// event count (u64), then per event the step delta since the previous event as a varint followed by
+// one byte holding the type in the high nibble and the value in the low nibble.
+class Replay
+{
+private:
+	int columns_;
+	int rows_;
+	std::uint64_t seed_;
+	std::uint64_t step_count_;
+	std::vector<ReplayEvent> events_;
+
+public:
+	Replay(int columns = 0, int rows = 0, std::uint64_t seed = 0);
+
+	void RecordTurn(Direction direction);
+
+	void RecordAutopilot(bool enabled, AutopilotMode autopilot_mode);
+
+	void RecordReset();
+
+	// Marks the end of a step; later events apply to the next one.
+	void RecordStep();
+
+	bool Save(const std::string& path) const;
+
+	// Rejects files with unknown event types or values. On failure the replay is left untouched.
+	bool Load(const std::string& path);
+
+	int Columns() const;
+
+	int Rows() const;
+
+	std::uint64_t Seed() const;
+
+	std::uint64_t StepCount() const;
+
+	const std::vector<ReplayEvent>& Events() const;
+};
+
+#endif
\ No newline at end of file
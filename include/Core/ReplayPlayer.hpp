@@ -0,0 +1,36 @@
+#ifndef REPLAY_PLAYER_HPP
+#define REPLAY_PLAYER_HPP
+
+#include "Core/Replay.hpp"
+#include "Core/Simulation.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Feeds a Replay into a Simulation one step at a time. The simulation must have been created with
+// the replay's board size and seed.
+class ReplayPlayer
+{
+private:
+	const Replay& replay_;
+	std::size_t next_event_;
+	std::uint64_t step_;
+	bool autopilot_;
+
+public:
+	explicit ReplayPlayer(const Replay& replay);
+
+	bool Done() const;
+
+	// Whether the next step starts a new game.
+	bool ResetPending() const;
+
+	// Applies the events recorded before the next step and plays it.
+	StepResult Advance(Simulation& simulation);
+
+	bool AutopilotEnabled() const;
+
+	std::uint64_t StepIndex() const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,60 @@
+#ifndef SEARCH_STATE_HPP
+#define SEARCH_STATE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Per-cell path search bookkeeping stored as parallel arrays indexed by grid index. A cell's entries are
+// only meaningful when its stamp matches the current search generation, so starting a new search is a
+// counter increment instead of a pass over the whole grid.
+class SearchState
+{
+private:
+	std::uint32_t generation_;
+	std::vector<std::uint32_t> seen_;
+	std::vector<std::uint32_t> closed_;
+	std::vector<int> parent_;
+	std::vector<int> local_cost_;
+
+public:
+	explicit SearchState(std::size_t cell_count = 0);
+
+	void Resize(std::size_t cell_count);
+
+	std::size_t Size() const;
+
+	void BeginSearch();
+
+	bool Seen(int index) const
+	{
+		return seen_[index] == generation_;
+	}
+
+	bool Closed(int index) const
+	{
+		return closed_[index] == generation_;
+	}
+
+	void Close(int index)
+	{
+		closed_[index] = generation_;
+	}
+
+	// Parent of a seen cell, -1 for the search root.
+	int Parent(int index) const
+	{
+		return parent_[index];
+	}
+
+	int LocalCost(int index) const;
+
+	void Relax(int index, int parent_index, int local_cost)
+	{
+		seen_[index] = generation_;
+		parent_[index] = parent_index;
+		local_cost_[index] = local_cost;
+	}
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,227 @@
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+
+#include "Core/Bitboard.hpp"
+#include "Core/DistanceField.hpp"
+#include "Core/FloodFill.hpp"
+#include "Core/FreeCellSet.hpp"
+#include "Core/Grid.hpp"
+#include "Core/HamiltonianCycle.hpp"
+#include "Core/SearchState.hpp"
+#include "Core/Snake.hpp"
+#include "Utils/Xoshiro256.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class StepResult
+{
+	MOVED, ATE_FOOD, COLLIDED, WON
+};
+
+enum class AutopilotMode
+{
+	A_STAR, HAMILTONIAN, DISTANCE_FIELD, MONTE_CARLO
+};
+
+// Rules of the game without any windowing or timing: the grid, the snake, the food and the autopilot.
+// The caller decides when a step happens and feeds in the direction for it.
+class Simulation
+{
+private:
+	// What a step in a rollout changed beyond the scalars saved by BeginRollout.
+	struct RolloutMove
+	{
+		int next_index_;
+		int tail_index_;
+		// What the ring-buffer slot the head moved into held before.
+		int overwritten_;
+		bool ate_food_;
+	};
+
+	struct RolloutStart
+	{
+		bool game_over_;
+		bool won_;
+		int tick_ms_;
+		int score_;
+		std::uint64_t steps_;
+		int released_cell_;
+		int food_;
+		std::uint64_t food_step_;
+		Direction direction_;
+		std::size_t snake_capacity_;
+	};
+
+	bool game_over_;
+	bool won_;
+	int tick_ms_;
+	int score_;
+	std::uint64_t steps_;
+	int released_cell_;
+
+	Grid grid_;
+	Snake snake_;
+	Bitboard occupancy_;
+	FreeCellSet free_cells_;
+	SearchState search_state_;
+	std::vector<int> shortest_path_cells_;
+	// The A* plan carries on from path_head_ at step path_step_, where its last move led. Anywhere else the
+	// snake was steered off it and it is planned again.
+	int path_head_;
+	std::uint64_t path_step_;
+	FloodFill flood_fill_;
+	Bitboard open_cells_;
+	Bitboard reachable_cells_;
+
+	AutopilotMode autopilot_mode_;
+	bool autopilot_wrapped_;
+	HamiltonianCycle cycle_;
+	bool cycle_aligned_;
+	std::uint64_t cycle_synced_step_;
+	DistanceField distance_field_;
+	std::uint64_t field_synced_step_;
+	int food_;
+	// Step at which the current food appeared, to notice the autopilot going round without eating.
+	std::uint64_t food_step_;
+
+	Xoshiro256 rng_;
+
+	bool rollout_active_;
+	RolloutStart rollout_start_;
+	std::vector<RolloutMove> rollout_moves_;
+
+	void IncrementScore();
+
+	void RebuildOccupancy();
+
+	void SpeedUp();
+
+	Direction AStarDirection();
+
+	// Flood-fills open_cells_ from the head with the tail cell opened up. Returns whether the tail is reachable.
+	bool TailReachable(int head_index, int tail_index);
+
+	// Whether the tail can still be reached once the snake has followed the planned path and eaten the food.
+	bool PathKeepsTailReachable();
+
+	// Whether the tail can still be reached once the head has moved to next_index, which must be enterable.
+	bool StepKeepsTailReachable(int next_index);
+
+	// Moves to a free cell from which the tail stays reachable, so the snake can wait for a safe path to the food.
+	Direction TailChaseDirection();
+
+	Direction HamiltonianDirection();
+
+	Direction DistanceFieldDirection();
+
+	bool SnakeFollowsCycle() const;
+
+public:
+	Simulation(int columns, int rows, std::uint64_t seed);
+
+	Simulation(const Simulation&) = delete;
+
+	Simulation& operator=(const Simulation&) = delete;
+
+	void Reset();
+
+	// Starts over with the given body (head first) instead of the default snake in the middle of the board.
+	void Reset(const std::vector<int>& body, Direction direction);
+
+	StepResult Step(Direction direction);
+
+	// Picks the next direction with the selected autopilot engine. Meant to be called once before every Step.
+	// MONTE_CARLO needs a MonteCarloPlanner to run its rollouts; on its own the Simulation plays A* instead.
+	Direction AutopilotDirection();
+
+	AutopilotMode GetAutopilotMode() const;
+
+	void SetAutopilotMode(AutopilotMode autopilot_mode);
+
+	// Lets the A* and distance-field autopilots plan through the board edges, which the snake can always cross.
+	bool AutopilotWrapped() const;
+
+	void SetAutopilotWrapped(bool wrapped);
+
+	// Distances to the food used by the distance-field autopilot; empty until that autopilot has run.
+	const DistanceField& GetDistanceField() const;
+
+	// Places the food on a uniformly chosen free cell. Returns false when the snake fills the whole board.
+	bool SpawnFood();
+
+	// Grid index of the food, or -1 once the board is full.
+	int Food() const;
+
+	const Grid& GetGrid() const;
+
+	const Snake& GetSnake() const;
+
+	const Bitboard& Occupancy() const;
+
+	bool IsOccupied(int index) const;
+
+	const std::vector<int>& ShortestPathCells() const;
+
+	void ClearShortestPath();
+
+	bool GameOver() const;
+
+	bool Won() const;
+
+	const FreeCellSet& FreeCells() const;
+
+	int Score() const;
+
+	int TickMs() const;
+
+	std::uint64_t Steps() const;
+
+	// Grid index the tail left during the last step, or -1 if the snake grew instead.
+	int ReleasedCell() const;
+
+	int NextCell(int index, Direction direction) const;
+
+	Direction DirectionTowards(int from_index, int to_index) const;
+
+	// Fills ShortestPathCells() with the path from the target back to the cell after start, avoiding the snake.
+	bool FindAStarPath(int start_index, int target_index, bool wrapped = false);
+
+	// Takes over the game state of another simulation on a board of the same size: the snake, the food, the score
+	// and the RNG. Autopilot plans are dropped rather than copied, and buffers are reused, so that rollouts can
+	// restart from a live game without allocating.
+	void CopyGameState(const Simulation& other);
+
+	// Steps from here on are logged until EndRollout takes them all back, so a rollout costs its own steps
+	// rather than a fresh CopyGameState. Autopilot plans are not restored and should not be used in between.
+	void BeginRollout();
+
+	// Returns to the state at BeginRollout, except for the RNG. Returns false if that
+	// is not possible because the snake's buffer grew during the rollout; the state must then be copied again.
+	bool EndRollout();
+
+	// Restarts the RNG that places the food, so that copies do not foresee where the real game's food will go.
+	void Reseed(std::uint64_t seed);
+
+	// The next value the RNG would produce, without advancing it.
+	std::uint64_t PeekRandom() const;
+
+	// Appends a pointer-free snapshot of the whole game state to bytes: the snake, the food, the score and speed,
+	// the autopilot's plan and the RNG, so that a restored game carries on exactly like the original would have.
+	// The free cells are rebuilt from the body on restore, so the size grows with the snake, not the board.
+	void Snapshot(std::vector<std::uint8_t>& bytes) const;
+
+	// Restores a snapshot taken on a board of the same size. On failure the game is left untouched.
+	bool Restore(const std::uint8_t* data, std::size_t size);
+
+	bool SaveSnapshot(const std::string& path) const;
+
+	bool LoadSnapshot(const std::string& path);
+
+	// Reads the board size out of a snapshot, to create a matching Simulation to restore it into.
+	static bool SnapshotBoardSize(const std::uint8_t* data, std::size_t size, int& columns, int& rows);
+};
+
+#endif
\ No newline at end of file
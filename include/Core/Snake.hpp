@@ -0,0 +1,82 @@
+#ifndef SNAKE_HPP
+#define SNAKE_HPP
+
+#include "Core/Direction.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// The body is a ring buffer of grid indices. Segment 0 is the head and lives at head_, the following
+// segments come after it (wrapping around), so moving and growing only touch one slot. The buffer starts
+// small and doubles when the snake outgrows it, up to the number of cells on the board.
+class Snake
+{
+private:
+	Direction direction_;
+	std::vector<int> segments_;
+	std::size_t head_;
+	std::size_t length_;
+	std::size_t max_length_;
+
+	void Grow(std::size_t capacity);
+
+public:
+	// Lays the snake out facing right, with its head in the middle of the board.
+	Snake(std::size_t segments_size, int columns, int rows);
+
+	// Takes an explicit body, head first. Consecutive segments are expected to be neighbouring cells.
+	Snake(const std::vector<int>& segments, Direction direction, int columns, int rows);
+
+	// Starts over with an explicit body like the constructor, but keeps the ring buffer when it is big enough.
+	void Reset(const std::vector<int>& segments, Direction direction);
+
+	std::size_t Length() const;
+
+	std::size_t Capacity() const;
+
+	int Segment(std::size_t i) const
+	{
+		const std::size_t position = head_ + i;
+
+		return segments_[position < segments_.size() ? position : position - segments_.size()];
+	}
+
+	int GetHead() const;
+
+	int GetTail() const;
+
+	Direction GetDirection() const;
+
+	void SetDirection(Direction direction);
+
+	void Move(int next_index, bool grow = false);
+
+	// Takes back the last Move. overwritten is what Segment(Capacity() - 1) held before that Move, and the
+	// capacity must not have changed since (a growing Move may have reallocated).
+	void Unmove(int overwritten, bool grew);
+
+	// Sets the direction without refusing a turn back, to put an earlier direction back.
+	void RestoreDirection(Direction direction);
+
+	std::vector<int> SnakeGridIndices() const;
+
+	// Visits the segments from head to tail, walking the ring buffer as at most two contiguous runs.
+	template <typename Visitor>
+	void ForEachSegment(Visitor visitor) const
+	{
+		const std::size_t first_run = std::min(length_, segments_.size() - head_);
+
+		for (std::size_t i = 0; i < first_run; ++i)
+		{
+			visitor(segments_[head_ + i]);
+		}
+
+		for (std::size_t i = 0; i < length_ - first_run; ++i)
+		{
+			visitor(segments_[i]);
+		}
+	}
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,77 @@
+#ifndef VECTOR_ENVIRONMENT_HPP
+#define VECTOR_ENVIRONMENT_HPP
+
+#include "Core/Direction.hpp"
+#include "Core/Simulation.hpp"
+#include "Utils/WorkStealingPool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Steps many independent games in lockstep for reinforcement learning, with the same rules as the game itself.
+// All buffers belong to the caller and are written in place, so a step allocates nothing:
+//  - actions: one Direction per game (0 left, 1 right, 2 up, 3 down); turning back onto the neck is ignored
+//    exactly like a key press would be.
+//  - observations: per game, plane_count planes of columns * rows bytes in grid index order, 1 where the
+//    plane's object is: body (without the head), head, food.
+//  - rewards: +1 for food, -1 for a collision, +1 for filling the board, 0 otherwise.
+//  - dones: 1 where the episode ended in this step, by a collision, a full board or the step limit. Those
+//    games are reset straight away and their observation already shows the next episode.
+// Passing the same observation buffer back every step, untouched, lets a step rewrite only the few cells that
+// changed instead of whole planes.
+class VectorEnvironment
+{
+public:
+	static constexpr int plane_count = 3;
+	static constexpr float food_reward = 1.0f;
+	static constexpr float collision_reward = -1.0f;
+	static constexpr float win_reward = 1.0f;
+
+private:
+	std::vector<std::unique_ptr<Simulation>> games_;
+	// Every episode starts from this body, so that resetting a game allocates nothing.
+	std::vector<int> start_body_;
+	Direction start_direction_;
+	std::vector<std::uint64_t> episode_steps_;
+	std::vector<int> observed_head_;
+	std::vector<int> observed_food_;
+	std::uint8_t* observations_;
+	std::unique_ptr<WorkStealingPool> pool_;
+	std::size_t chunk_size_;
+	std::uint64_t max_episode_steps_;
+
+	void WriteObservation(std::size_t game, std::uint8_t* observations);
+
+	// Brings the observation written by the previous step up to date after an ordinary step.
+	void UpdateObservation(std::size_t game, std::uint8_t* observations);
+
+	template <typename Work>
+	void ForEachGame(Work work);
+
+public:
+	// Game i is seeded with seed + i. max_episode_steps of 0 lets episodes run until they end by themselves.
+	VectorEnvironment(std::size_t game_count, int columns, int rows, std::uint64_t seed, std::uint64_t max_episode_steps = 0, 
+		std::size_t thread_count = 1);
+
+	~VectorEnvironment();
+
+	VectorEnvironment(const VectorEnvironment&) = delete;
+
+	VectorEnvironment& operator=(const VectorEnvironment&) = delete;
+
+	std::size_t GameCount() const;
+
+	// Bytes of one game's observation: plane_count * columns * rows.
+	std::size_t ObservationSize() const;
+
+	// Starts a new episode in every game and writes the first observations.
+	void Reset(std::uint8_t* observations);
+
+	void Step(const std::uint8_t* actions, std::uint8_t* observations, float* rewards, std::uint8_t* dones);
+
+	const Simulation& GetSimulation(std::size_t game) const;
+};
+
+#endif
\ No newline at end of file
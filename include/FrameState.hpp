@@ -0,0 +1,37 @@
+#ifndef FRAME_STATE_HPP
+#define FRAME_STATE_HPP
+
+#include "BoardRenderer.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct CellChange
+{
+	int index_;
+	CellColour colour_;
+};
+
+// Everything the render thread needs to draw one frame, copied out of the simulation after each change.
+// The board travels as the cell changes since the last frame the render thread drew, so a step costs a
+// handful of cells whatever the snake's length. The vectors keep their capacity between publishes, so
+// steady-state publishing does not allocate.
+struct FrameState
+{
+	// Increases with every publish; the render thread reports the serial it drew back to the simulation.
+	std::uint64_t serial_ = 0;
+	// The board is cleared before changes_ are applied: on the first frame, after a reset, or once the
+	// render thread fell so far behind that a whole board was cheaper to send.
+	bool clear_ = false;
+	// Oldest first; applying them in order to the board of any frame drawn since brings it up to date.
+	std::vector<CellChange> changes_;
+	bool game_over_ = false;
+
+	char score_text_[32] = {};
+	char controls_status_text_[96] = {};
+	// Tick and pathfinding timings over the last second, measured on the simulation thread.
+	std::string metrics_text_;
+};
+
+#endif
\ No newline at end of file
@@ -4,45 +4,140 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 
+#include "Core/Snake.hpp"
+#include "FrameState.hpp"
+#include "Utils/SpscQueue.hpp"
+#include "Utils/TripleBuffer.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
-#include <random>
-
-class Snake;
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class BoardRenderer;
+class GlyphAtlas;
+class IncrementalPlanner;
+class Metrics;
+class MonteCarloPlanner;
+class Replay;
+class ReplayPlayer;
+class Simulation;
 class Texture;
-class GridCell;
 
+// The simulation runs on its own thread and publishes a FrameState after every change; the main thread
+// handles SDL events, forwards the game's keys to the simulation and renders the latest published frame.
+// Neither side waits for the other.
 class Game
 {
 private:
+	struct KeyInput
+	{
+		Uint32 type_;
+		SDL_Keycode sym_;
+		Uint8 repeat_;
+		// Performance counter when the main thread received the key.
+		std::uint64_t counter_;
+	};
+
+	struct QueuedTurn
+	{
+		Direction direction_;
+		std::uint64_t counter_;
+	};
+
+	struct JournalEntry
+	{
+		CellChange change_;
+		// Serial of the first frame that carries the change.
+		std::uint64_t serial_;
+	};
+
+	static constexpr std::size_t max_queued_turns = 3;
+
 	const char* title_;
 	int screen_width_;
 	int screen_height_;
-	bool is_running_;
+	std::atomic<bool> is_running_;
 	bool game_over_;
 	bool paused_;
 	bool autopilot_toggle_;
 	bool shortest_path_toggle_;
 	bool wrapped_shortest_path_toggle_;
 	bool info_toggle_;
-	int last_ms_;
-	int tick_ms_;
-	int score_;
+	// Set by the main thread, read by the simulation thread to decide whether to format its timings.
+	std::atomic<bool> metrics_toggle_;
+	bool needs_render_;
+	double playback_speed_;
+	bool vsync_;
+	int frame_rate_;
+	std::uint64_t next_step_;
+	// Arrow-key turns not applied yet, oldest first. Each step takes one, so quick turn sequences
+	// within a tick are played out over the following steps instead of dropped.
+	std::vector<QueuedTurn> queued_turns_;
+	// Board changes not yet drawn by the render thread, oldest first. The snake, food and path as of the
+	// last publish are kept to derive the next changes from.
+	std::vector<JournalEntry> journal_;
+	std::uint64_t frame_serial_;
+	std::uint64_t clear_serial_;
+	bool board_resync_;
+	std::uint64_t published_steps_;
+	int published_head_;
+	int published_food_;
+	std::vector<int> published_path_;
+	std::vector<int> next_path_;
+	// Bit 1: cell of published_path_, bit 2: cell of next_path_.
+	std::vector<std::uint8_t> path_marks_;
+	// Serial of the last frame the render thread applied to the board.
+	std::atomic<std::uint64_t> drawn_serial_;
 	int grid_cell_side_;
+	int board_x_;
+	int board_y_;
 
-	std::unique_ptr<Texture> score_info_;
 	std::unique_ptr<Texture> controls_info_;
 	std::unique_ptr<Texture> toggle_info_;
-	std::unique_ptr<Texture> toggled_controls_info_;
 	std::unique_ptr<Texture> game_over_info_;
-
-	std::vector<GridCell> grid_;
-	std::unique_ptr<Snake> snake_;
-	std::vector<GridCell*> shortest_path_cells_;
-	GridCell* food_;
-
-	std::mt19937_64 mt_;
-	std::uniform_int_distribution<int> random_x_;
-  	std::uniform_int_distribution<int> random_y_;
+	std::unique_ptr<GlyphAtlas> glyph_atlas_;
+
+	// Dynamic HUD text, drawn from the glyph atlas. The score and controls status are written by the
+	// simulation thread and reach the renderer through FrameState.
+	char score_text_[32];
+	char controls_status_text_[96];
+	std::string metrics_text_;
+	std::string simulation_metrics_text_;
+
+	std::unique_ptr<Simulation> simulation_;
+	std::unique_ptr<IncrementalPlanner> planner_;
+	// Created the first time the Monte Carlo autopilot runs, so its worker threads only exist when needed.
+	std::unique_ptr<MonteCarloPlanner> lookahead_;
+	// Frame and render timings, recorded on the main thread.
+	std::unique_ptr<Metrics> metrics_;
+	// Tick and pathfinding timings, recorded on the simulation thread.
+	std::unique_ptr<Metrics> simulation_metrics_;
+	std::unique_ptr<BoardRenderer> board_;
+
+	// Every session is recorded and saved to record_path_ on exit if one is set. A playback replaces
+	// keyboard and autopilot input with the player.
+	std::unique_ptr<Replay> recording_;
+	std::string record_path_;
+	std::unique_ptr<Replay> playback_;
+	std::unique_ptr<ReplayPlayer> player_;
+	std::string metrics_csv_path_;
+
+	std::thread simulation_thread_;
+	TripleBuffer<FrameState> frames_;
+	SpscQueue<KeyInput, 64> input_;
+	// Wakes the simulation thread early when input arrives or the game stops.
+	std::mutex wake_mutex_;
+	std::condition_variable wake_condition_;
+	bool wake_;
+	// The simulation thread pushes an SDL event of frame_event_type_ to wake the main thread after it
+	// publishes, at most one at a time.
+	Uint32 frame_event_type_;
+	std::atomic<bool> frame_event_pending_;
 
 	SDL_Window* window_;
 	SDL_Renderer* renderer_;
@@ -52,10 +147,41 @@ private:
 	
 	bool InitInfoTextures();
 
+	// Builds the glyph atlas and the static text textures from font_, again after the renderer lost them.
+	bool LoadTextTextures();
+
 	void Finalize();
 
+	// Sleeps until deadline (a performance counter value) or until an event arrives, whichever is first.
+	void WaitUntil(std::uint64_t deadline);
+
+	// Body of the simulation thread: applies queued input, steps the game and publishes frames until Stop.
+	void SimulationLoop();
+
+	// Sleeps on the simulation thread until deadline (a performance counter value) or until woken.
+	void WaitForInput(std::uint64_t deadline);
+
+	void ApplyInput(const KeyInput& input);
+
+	// Copies the drawable state into the triple buffer and wakes the main thread.
+	void Publish();
+
+	// Appends the board changes since the last publish to journal_: the cells around the head, tail and
+	// food after one step and the difference between the old and new path, or the whole board after a
+	// reset or any other jump.
+	void RecordBoardChanges();
+
+	// Appends the difference between published_path_ and the path shown now.
+	void RecordPathChanges();
+
+	void RecordCell(int index, CellColour colour);
+
+	// Applies the frame's changes to the board.
+	void SyncBoard(const FrameState& frame);
+
 public:
-	Game();
+	// The board is columns x rows cells, scaled to fit the window.
+	Game(int columns, int rows, std::uint64_t seed);
 	
 	~Game();
 
@@ -67,33 +193,45 @@ public:
 	
 	void Reset();
 
+	// Main thread: handles window and overlay events and queues every other key for the simulation thread.
 	void HandleEvents();
 	
-	void Tick();
+	// Simulation thread: steps the simulation if its next step is due; returns whether it did.
+	bool Tick();
 	
+	// Main thread: draws the latest published frame.
 	void Render();
 
-	void SpawnFood();
+	void UpdateScore();
+
+	void UpdateControlsStatus();
 
-	GridCell* Food();
+	// Redraws the frame and render lines of the metrics overlay from the last one-second window.
+	void UpdateMetricsInfo(int frames);
 
-	std::vector<GridCell>& Grid();
+	// Reformats the tick and pathfinding lines of the metrics overlay on the simulation thread.
+	void UpdateSimulationMetricsInfo(int ticks);
 
-	void IncrementScore();
+	// Where the frame, tick, render and pathfinding timings are written on exit; empty to skip.
+	void SetMetricsCsvPath(const std::string& path);
 
-	void UpdateScore();
+	// Upper bound on rendered frames per second; 0 renders every state change as soon as it happens.
+	// Frames are only drawn when something changed either way.
+	void SetFrameRate(int frame_rate);
 
-	void UpdateControlsStatus();
+	void SetVsync(bool vsync);
 
-	void SpeedUp();
+	void SetRecordPath(const std::string& path);
 
-	int ConvertXYToGridIndex(int x, int y);
+	// Plays replay back instead of taking input; the game must have been created with its board size and seed.
+	// speed scales the step rate and can be changed in game with '+' and '-'.
+	void SetPlayback(std::unique_ptr<Replay> replay, double speed);
+
+	const char* AutopilotStatus() const;
 
 	bool AutopilotToggled() const;
 	
 	bool WrappedShortestPathToggled() const;
-
-	bool FindAStarPath(GridCell* start_cell, GridCell* target_cell, bool wrapped = false);
 };
 
 #endif
\ No newline at end of file
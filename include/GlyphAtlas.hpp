@@ -0,0 +1,53 @@
+#ifndef GLYPH_ATLAS_HPP
+#define GLYPH_ATLAS_HPP
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <array>
+
+// Printable ASCII rasterised once into a single white texture. Text is drawn as one textured quad
+// per character, tinted through the texture colour modulation, so changing strings costs no
+// rasterisation, texture upload or allocation.
+class GlyphAtlas
+{
+private:
+	static constexpr char first_glyph = ' ';
+	static constexpr char last_glyph = '~';
+	static constexpr int glyph_count = last_glyph - first_glyph + 1;
+
+	struct Glyph
+	{
+		SDL_Rect source_;
+		int advance_;
+	};
+
+	SDL_Texture* texture_;
+	std::array<Glyph, glyph_count> glyphs_;
+	int line_skip_;
+
+	const Glyph* Find(char c) const;
+
+public:
+	GlyphAtlas();
+
+	~GlyphAtlas();
+
+	GlyphAtlas(const GlyphAtlas&) = delete;
+
+	GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+	bool Build(SDL_Renderer* renderer, TTF_Font* font);
+
+	void Free();
+
+	// Characters outside the atlas are skipped; '\n' starts a new line at x.
+	void Render(SDL_Renderer* renderer, const char* text, int x, int y, const SDL_Color& color) const;
+
+	// Width of the widest line.
+	int Width(const char* text) const;
+
+	int Height(const char* text) const;
+};
+
+#endif
\ No newline at end of file
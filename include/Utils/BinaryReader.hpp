@@ -0,0 +1,31 @@
+#ifndef BINARY_READER_HPP
+#define BINARY_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Reads what BinaryWriter wrote. Every read returns false instead of running past the end of the data.
+class BinaryReader
+{
+private:
+	const std::uint8_t* data_;
+	std::size_t size_;
+	std::size_t offset_;
+
+public:
+	BinaryReader(const std::uint8_t* data, std::size_t size);
+
+	std::size_t Remaining() const;
+
+	bool ReadBytes(void* data, std::size_t size);
+
+	bool ReadUint(std::uint64_t& value, int size);
+
+	bool ReadVarint(std::uint64_t& value);
+
+	static bool ReadFile(const std::string& path, std::vector<std::uint8_t>& bytes);
+};
+
+#endif
\ No newline at end of file
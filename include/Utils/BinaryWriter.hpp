@@ -0,0 +1,27 @@
+#ifndef BINARY_WRITER_HPP
+#define BINARY_WRITER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Appends little endian integers and LEB128 varints to a byte buffer.
+class BinaryWriter
+{
+private:
+	std::vector<std::uint8_t>& bytes_;
+
+public:
+	explicit BinaryWriter(std::vector<std::uint8_t>& bytes);
+
+	void WriteBytes(const void* data, std::size_t size);
+
+	void WriteUint(std::uint64_t value, int size);
+
+	void WriteVarint(std::uint64_t value);
+
+	static bool WriteFile(const std::string& path, const std::vector<std::uint8_t>& bytes);
+};
+
+#endif
\ No newline at end of file
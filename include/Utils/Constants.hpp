@@ -6,6 +6,8 @@ namespace constants
 	inline constexpr char game_title[] = "Snake"; 
 	inline constexpr int screen_width = 1200;
 	inline constexpr int screen_height = 900;
+	inline constexpr int default_grid_columns = 24;
+	inline constexpr int default_grid_rows = 18;
 } // namespace constants
 
 #endif
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef HISTOGRAM_HPP
+#define HISTOGRAM_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Log-linear histogram of nanosecond samples: eight buckets per power of two, so any reported
+// percentile is within 12.5% of the true value. Recording is a handful of integer operations.
+class Histogram
+{
+public:
+	static constexpr std::size_t sub_buckets = 8;
+	static constexpr std::size_t bucket_count = 62 * sub_buckets;
+
+private:
+	std::array<std::uint64_t, bucket_count> counts_;
+	std::uint64_t count_;
+	std::uint64_t total_;
+	std::uint64_t max_;
+
+	static std::size_t BucketIndex(std::uint64_t value);
+
+public:
+	Histogram();
+
+	void Clear();
+
+	void Record(std::uint64_t value);
+
+	// Adds the samples of other to this histogram.
+	void Merge(const Histogram& other);
+
+	std::uint64_t Count() const;
+
+	std::uint64_t Max() const;
+
+	double Mean() const;
+
+	// Upper bound of the bucket holding the given percentile (0 to 100), clamped to the maximum sample.
+	std::uint64_t Percentile(double percentile) const;
+
+	std::uint64_t BucketCount(std::size_t index) const;
+
+	static std::uint64_t BucketLower(std::size_t index);
+
+	static std::uint64_t BucketUpper(std::size_t index);
+};
+
+#endif
\ No newline at end of file
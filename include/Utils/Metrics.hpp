@@ -0,0 +1,55 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include "Utils/Histogram.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+enum class Metric
+{
+	FRAME, 
+	TICK, 
+	RENDER, 
+	PATHFINDING, 
+	// From a key press reaching the game to the step that applied it.
+	INPUT_LATENCY, 
+	COUNT
+};
+
+// Per-sample timings kept in two sets of histograms: one over the whole run, written out as CSV,
+// and one over the current window, which the caller rolls over (e.g. once a second) for live display.
+class Metrics
+{
+private:
+	static constexpr std::size_t metric_count = static_cast<std::size_t>(Metric::COUNT);
+
+	std::array<Histogram, metric_count> total_;
+	std::array<Histogram, metric_count> window_;
+	std::array<Histogram, metric_count> last_window_;
+
+public:
+	static const char* Name(Metric metric);
+
+	void Record(Metric metric, std::uint64_t nanoseconds);
+
+	// Makes the current window the one returned by LastWindow and starts a new one.
+	void RollWindow();
+
+	// Adds other's run totals to these, e.g. to write the timings of several threads to one CSV.
+	void Merge(const Metrics& other);
+
+	const Histogram& Total(Metric metric) const;
+
+	const Histogram& LastWindow(Metric metric) const;
+
+	// One line per metric: count, mean, p50, p99 and max in microseconds.
+	std::string Summary(Metric metric, bool last_window) const;
+
+	// Writes the run totals to path and their non-empty buckets to histogram_path.
+	bool WriteCsv(const std::string& path, const std::string& histogram_path) const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Fixed-capacity ring buffer between exactly one producer thread and one consumer thread, without locks.
+template <typename T, std::size_t Capacity>
+class SpscQueue
+{
+private:
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+	std::array<T, Capacity> items_;
+	// Free-running counters; only the producer moves tail_ and only the consumer moves head_.
+	std::atomic<std::size_t> head_;
+	std::atomic<std::size_t> tail_;
+
+public:
+	SpscQueue() : items_(), head_(0), tail_(0)
+	{
+	}
+
+	SpscQueue(const SpscQueue&) = delete;
+
+	SpscQueue& operator=(const SpscQueue&) = delete;
+
+	// Producer side. Returns false and drops item when the queue is full.
+	bool TryPush(const T& item)
+	{
+		const std::size_t tail = tail_.load(std::memory_order_relaxed);
+
+		if (tail - head_.load(std::memory_order_acquire) == Capacity)
+		{
+			return false;
+		}
+
+		items_[tail & (Capacity - 1)] = item;
+		tail_.store(tail + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	// Consumer side.
+	bool TryPop(T& item)
+	{
+		const std::size_t head = head_.load(std::memory_order_relaxed);
+
+		if (head == tail_.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		item = items_[head & (Capacity - 1)];
+		head_.store(head + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	bool Empty() const
+	{
+		return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+	}
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Hands the latest value from one writer thread to one reader thread without locks or waiting. The writer
+// fills WriteBuffer and publishes it; the reader takes the most recently published one with Update and reads
+// it until the next Update. Values published in between are skipped, never torn. A published buffer comes back
+// to the writer with stale contents, so every publish has to write the whole value.
+template <typename T>
+class TripleBuffer
+{
+private:
+	// The low two bits of middle_ index the buffer between the two sides; fresh_bit is set while it holds
+	// a value the reader has not taken yet.
+	static constexpr std::uint8_t fresh_bit = 4;
+	static constexpr std::uint8_t index_mask = 3;
+
+	std::array<T, 3> buffers_;
+	std::atomic<std::uint8_t> middle_;
+	std::uint8_t write_index_;
+	std::uint8_t read_index_;
+
+public:
+	TripleBuffer() : buffers_(), middle_(1), write_index_(0), read_index_(2)
+	{
+	}
+
+	TripleBuffer(const TripleBuffer&) = delete;
+
+	TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+	T& WriteBuffer()
+	{
+		return buffers_[write_index_];
+	}
+
+	void Publish()
+	{
+		write_index_ = middle_.exchange(write_index_ | fresh_bit, std::memory_order_acq_rel) & index_mask;
+	}
+
+	// Switches ReadBuffer to the latest published value; returns false if nothing new was published.
+	bool Update()
+	{
+		if ((middle_.load(std::memory_order_relaxed) & fresh_bit) == 0)
+		{
+			return false;
+		}
+
+		read_index_ = middle_.exchange(read_index_, std::memory_order_acq_rel) & index_mask;
+
+		return true;
+	}
+
+	const T& ReadBuffer() const
+	{
+		return buffers_[read_index_];
+	}
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef WORK_STEALING_POOL_HPP
+#define WORK_STEALING_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs batches of independent tasks on a fixed set of threads. Each worker pops from the back of its own
+// queue and, once that is empty, steals from the front of the other workers' queues.
+class WorkStealingPool
+{
+public:
+	using Task = std::function<void(std::size_t task_index, std::size_t worker_index)>;
+
+private:
+	// A worker's share of a batch is one contiguous run of task indices, [first_, last_), so handing it out
+	// allocates nothing.
+	struct WorkQueue
+	{
+		std::mutex mutex_;
+		std::size_t first_ = 0;
+		std::size_t last_ = 0;
+	};
+
+	std::vector<std::unique_ptr<WorkQueue>> queues_;
+	std::vector<std::thread> threads_;
+
+	std::mutex mutex_;
+	std::condition_variable job_ready_;
+	std::condition_variable job_done_;
+	const Task* task_;
+	std::uint64_t job_generation_;
+	std::size_t busy_workers_;
+	bool stopping_;
+
+	void WorkerLoop(std::size_t worker_index);
+
+	void Drain(std::size_t worker_index);
+
+	bool PopTask(std::size_t worker_index, std::size_t& task_index);
+
+	bool StealTask(std::size_t worker_index, std::size_t& task_index);
+
+public:
+	explicit WorkStealingPool(std::size_t worker_count = std::thread::hardware_concurrency());
+
+	~WorkStealingPool();
+
+	WorkStealingPool(const WorkStealingPool&) = delete;
+
+	WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+	std::size_t WorkerCount() const;
+
+	// Blocks until task has been called once for every index in [0, task_count). The calling thread works as worker 0.
+	void Run(std::size_t task_count, const Task& task);
+};
+
+#endif
\ No newline at end of file
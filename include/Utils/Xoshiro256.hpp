@@ -0,0 +1,52 @@
+#ifndef XOSHIRO256_HPP
+#define XOSHIRO256_HPP
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+// The SplitMix64 mixer: a well spread 64-bit hash of value. Feeding it a counter stepped by any odd constant
+// gives a fast stream of seeds.
+inline std::uint64_t SplitMix64(std::uint64_t value)
+{
+	value += 0x9e3779b97f4a7c15ULL;
+	value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+
+	return value ^ (value >> 31);
+}
+
+// xoshiro256** behind the standard random bit generator interface, so it works with the <random> distributions.
+// The whole state is four words, which snapshots store as they are.
+class Xoshiro256
+{
+private:
+	std::array<std::uint64_t, 4> state_;
+
+public:
+	using result_type = std::uint64_t;
+
+	explicit Xoshiro256(std::uint64_t seed = 0);
+
+	static constexpr result_type min()
+	{
+		return 0;
+	}
+
+	static constexpr result_type max()
+	{
+		return std::numeric_limits<result_type>::max();
+	}
+
+	// Expands seed into the four state words through SplitMix64.
+	void Seed(std::uint64_t seed);
+
+	result_type operator()();
+
+	const std::array<std::uint64_t, 4>& State() const;
+
+	// Returns false and keeps the current state for all zeros, from which the generator only ever yields zero.
+	bool SetState(const std::array<std::uint64_t, 4>& state);
+};
+
+#endif
\ No newline at end of file
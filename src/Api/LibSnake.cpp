@@ -0,0 +1,235 @@
+#include "Api/LibSnake.h"
+#include "Core/Direction.hpp"
+#include "Core/MonteCarloPlanner.hpp"
+#include "Core/Simulation.hpp"
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+struct snake_game
+{
+	Simulation simulation_;
+	// Only created once the Monte Carlo autopilot is selected or restored.
+	std::unique_ptr<MonteCarloPlanner> lookahead_;
+	// Reused by snake_snapshot so that repeated snapshots do not allocate.
+	std::vector<std::uint8_t> snapshot_;
+
+	snake_game(int columns, int rows, std::uint64_t seed) : simulation_(columns, rows, seed)
+	{
+	}
+};
+
+namespace
+{
+	// Also called before every Monte Carlo decision, since a restored snapshot can select that autopilot
+	// without snake_set_autopilot.
+	bool EnsureLookahead(snake_game* game)
+	{
+		if (game->lookahead_ != nullptr)
+		{
+			return true;
+		}
+
+		// Callers own their threading, so the rollouts run on the calling thread.
+		try
+		{
+			game->lookahead_ = std::make_unique<MonteCarloPlanner>(1);
+		}
+		catch (...)
+		{
+			return false;
+		}
+
+		return true;
+	}
+} // namespace
+
+uint32_t snake_api_version(void)
+{
+	return SNAKE_API_VERSION;
+}
+
+snake_game* snake_create(int columns, int rows, uint64_t seed)
+{
+	// Every cell index in the core is an int.
+	if (columns < 1 || rows < 1 || columns > INT_MAX / rows)
+	{
+		return nullptr;
+	}
+
+	// The core never throws, but allocation can, and nothing may unwind into C callers.
+	try
+	{
+		return new snake_game(columns, rows, seed);
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+void snake_destroy(snake_game* game)
+{
+	delete game;
+}
+
+void snake_reset(snake_game* game)
+{
+	try
+	{
+		game->simulation_.Reset();
+	}
+	catch (...)
+	{
+	}
+}
+
+int snake_step(snake_game* game, int direction)
+{
+	if (direction < SNAKE_LEFT || direction > SNAKE_DOWN)
+	{
+		return -1;
+	}
+
+	try
+	{
+		return static_cast<int>(game->simulation_.Step(static_cast<Direction>(direction)));
+	}
+	catch (...)
+	{
+		return -1;
+	}
+}
+
+int snake_set_autopilot(snake_game* game, int autopilot, int wrapped)
+{
+	if (autopilot < SNAKE_AUTOPILOT_A_STAR || autopilot > SNAKE_AUTOPILOT_MONTE_CARLO)
+	{
+		return 0;
+	}
+
+	if (autopilot == SNAKE_AUTOPILOT_MONTE_CARLO && !EnsureLookahead(game))
+	{
+		return 0;
+	}
+
+	game->simulation_.SetAutopilotMode(static_cast<AutopilotMode>(autopilot));
+	game->simulation_.SetAutopilotWrapped(wrapped != 0);
+
+	return 1;
+}
+
+int snake_autopilot_direction(snake_game* game)
+{
+	try
+	{
+		if (game->simulation_.GetAutopilotMode() == AutopilotMode::MONTE_CARLO)
+		{
+			return EnsureLookahead(game) ? static_cast<int>(game->lookahead_->ChooseDirection(game->simulation_)) : -1;
+		}
+
+		return static_cast<int>(game->simulation_.AutopilotDirection());
+	}
+	catch (...)
+	{
+		return -1;
+	}
+}
+
+int snake_columns(const snake_game* game)
+{
+	return game->simulation_.GetGrid().Columns();
+}
+
+int snake_rows(const snake_game* game)
+{
+	return game->simulation_.GetGrid().Rows();
+}
+
+int snake_score(const snake_game* game)
+{
+	return game->simulation_.Score();
+}
+
+uint64_t snake_steps(const snake_game* game)
+{
+	return game->simulation_.Steps();
+}
+
+int snake_game_over(const snake_game* game)
+{
+	return game->simulation_.GameOver() ? 1 : 0;
+}
+
+int snake_won(const snake_game* game)
+{
+	return game->simulation_.Won() ? 1 : 0;
+}
+
+int snake_direction(const snake_game* game)
+{
+	return static_cast<int>(game->simulation_.GetSnake().GetDirection());
+}
+
+int snake_food(const snake_game* game)
+{
+	return game->simulation_.Food();
+}
+
+size_t snake_length(const snake_game* game)
+{
+	return game->simulation_.GetSnake().Length();
+}
+
+size_t snake_body(const snake_game* game, int* cells, size_t capacity)
+{
+	std::size_t i = 0;
+
+	game->simulation_.GetSnake().ForEachSegment([cells, capacity, &i](int index)
+	{
+		if (i < capacity)
+		{
+			cells[i] = index;
+		}
+
+		++i;
+	});
+
+	return i;
+}
+
+size_t snake_snapshot(snake_game* game, uint8_t* buffer, size_t capacity)
+{
+	try
+	{
+		game->snapshot_.clear();
+		game->simulation_.Snapshot(game->snapshot_);
+	}
+	catch (...)
+	{
+		return 0;
+	}
+
+	if (game->snapshot_.size() <= capacity)
+	{
+		std::memcpy(buffer, game->snapshot_.data(), game->snapshot_.size());
+	}
+
+	return game->snapshot_.size();
+}
+
+int snake_restore(snake_game* game, const uint8_t* data, size_t size)
+{
+	try
+	{
+		return game->simulation_.Restore(data, size) ? 1 : 0;
+	}
+	catch (...)
+	{
+		return 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include "BoardRenderer.hpp"
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+
+namespace
+{
+	constexpr SDL_Color palette[] = {
+		{ 0x00, 0x00, 0x00, 0xFF }, 
+		{ 0xFF, 0xFF, 0x00, 0xFF }, 
+		{ 0x00, 0xFF, 0x00, 0xFF }, 
+		{ 0x00, 0x00, 0xFF, 0xFF }, 
+		{ 0xFF, 0x00, 0x00, 0xFF }
+	};
+} // namespace
+
+BoardRenderer::BoardRenderer() : columns_(0), rows_(0), cell_side_(0), full_redraw_(true), texture_(nullptr)
+{
+}
+
+BoardRenderer::~BoardRenderer()
+{
+	Free();
+}
+
+bool BoardRenderer::Initialize(SDL_Renderer* renderer, int columns, int rows, int cell_side)
+{
+	Free();
+
+	columns_ = columns;
+	rows_ = rows;
+	cell_side_ = cell_side;
+
+	const std::size_t cell_count = static_cast<std::size_t>(columns) * rows;
+
+	pending_.assign(cell_count, CellColour::EMPTY);
+	drawn_.assign(cell_count, CellColour::EMPTY);
+	dirty_.assign(cell_count, 0);
+	dirty_cells_.clear();
+
+	return RecreateTexture(renderer);
+}
+
+bool BoardRenderer::RecreateTexture(SDL_Renderer* renderer)
+{
+	Free();
+	Invalidate();
+
+	texture_ = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, columns_ * cell_side_, rows_ * cell_side_);
+
+	if (texture_ == nullptr)
+	{
+		printf("Board texture could not be created, drawing the board directly! SDL Error: %s\n", SDL_GetError());
+		return false;
+	}
+
+	return true;
+}
+
+void BoardRenderer::Free()
+{
+	if (texture_ != nullptr)
+	{
+		SDL_DestroyTexture(texture_);
+		texture_ = nullptr;
+	}
+}
+
+void BoardRenderer::Clear()
+{
+	std::fill(pending_.begin(), pending_.end(), CellColour::EMPTY);
+	Invalidate();
+}
+
+void BoardRenderer::Invalidate()
+{
+	for (int index : dirty_cells_)
+	{
+		dirty_[index] = 0;
+	}
+
+	dirty_cells_.clear();
+	full_redraw_ = true;
+}
+
+SDL_Rect BoardRenderer::CellRect(int index) const
+{
+	return { (index % columns_) * cell_side_, (index / columns_) * cell_side_, cell_side_, cell_side_ };
+}
+
+void BoardRenderer::DrawBatches(SDL_Renderer* renderer)
+{
+	for (std::size_t colour = 0; colour < colour_count; ++colour)
+	{
+		std::vector<SDL_Rect>& batch = batches_[colour];
+
+		if (!batch.empty())
+		{
+			SDL_SetRenderDrawColor(renderer, palette[colour].r, palette[colour].g, palette[colour].b, palette[colour].a);
+			SDL_RenderFillRects(renderer, batch.data(), static_cast<int>(batch.size()));
+			batch.clear();
+		}
+	}
+}
+
+void BoardRenderer::Flush(SDL_Renderer* renderer)
+{
+	if (texture_ == nullptr)
+	{
+		return;
+	}
+
+	SDL_SetRenderTarget(renderer, texture_);
+
+	if (full_redraw_)
+	{
+		SDL_SetRenderDrawColor(renderer, palette[0].r, palette[0].g, palette[0].b, palette[0].a);
+		SDL_RenderClear(renderer);
+
+		for (std::size_t index = 0; index < pending_.size(); ++index)
+		{
+			if (pending_[index] != CellColour::EMPTY)
+			{
+				batches_[static_cast<std::size_t>(pending_[index])].push_back(CellRect(static_cast<int>(index)));
+			}
+		}
+
+		drawn_ = pending_;
+		full_redraw_ = false;
+	}
+	else
+	{
+		for (int index : dirty_cells_)
+		{
+			dirty_[index] = 0;
+
+			if (pending_[index] != drawn_[index])
+			{
+				drawn_[index] = pending_[index];
+				batches_[static_cast<std::size_t>(pending_[index])].push_back(CellRect(index));
+			}
+		}
+
+		dirty_cells_.clear();
+	}
+
+	DrawBatches(renderer);
+	SDL_SetRenderTarget(renderer, nullptr);
+}
+
+void BoardRenderer::Render(SDL_Renderer* renderer, int x, int y)
+{
+	if (texture_ != nullptr)
+	{
+		const SDL_Rect destination = { x, y, columns_ * cell_side_, rows_ * cell_side_ };
+		SDL_RenderCopy(renderer, texture_, nullptr, &destination);
+		return;
+	}
+
+	for (std::size_t index = 0; index < pending_.size(); ++index)
+	{
+		if (pending_[index] != CellColour::EMPTY)
+		{
+			SDL_Rect rect = CellRect(static_cast<int>(index));
+			rect.x += x;
+			rect.y += y;
+			batches_[static_cast<std::size_t>(pending_[index])].push_back(rect);
+		}
+	}
+
+	for (int index : dirty_cells_)
+	{
+		dirty_[index] = 0;
+	}
+
+	dirty_cells_.clear();
+	DrawBatches(renderer);
+}
\ No newline at end of file
@@ -0,0 +1,364 @@
+#include "Core/Arena.hpp"
+#include "Core/Direction.hpp"
+#include "Core/Grid.hpp"
+#include "Utils/WorkStealingPool.hpp"
+#include "Utils/Xoshiro256.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+	constexpr Direction directions[] = { Direction::LEFT, Direction::RIGHT, Direction::UP, Direction::DOWN };
+
+	// Enough chunks per worker for stealing to even out the load, but big enough to amortise the task.
+	constexpr std::size_t chunks_per_worker = 8;
+	constexpr std::size_t min_chunk_size = 256;
+
+	// Placement gives up after this many random probes, so a crowded board cannot stall a tick.
+	constexpr int spawn_attempts = 64;
+
+	std::uint64_t NextRandom(std::uint64_t& state)
+	{
+		const std::uint64_t value = SplitMix64(state);
+		state += 0x9e3779b97f4a7c15ULL;
+
+		return value;
+	}
+
+	std::uint64_t HashCombine(std::uint64_t hash, std::uint64_t value)
+	{
+		return (hash ^ value) * 0x100000001b3ULL;
+	}
+} // namespace
+
+Arena::Arena(int columns, int rows, std::size_t snake_count, std::size_t spawn_length, std::size_t capacity, 
+	std::size_t food_count, std::uint64_t seed, std::size_t thread_count) : 
+	grid_(columns, rows), 
+	capacity_(std::max<std::size_t>(capacity, 1)), 
+	spawn_length_(std::clamp<std::size_t>(spawn_length, 1, capacity_)), 
+	food_target_(food_count), 
+	cells_(grid_.CellCount(), empty_cell), 
+	claims_(std::make_unique<std::atomic<std::uint8_t>[]>(grid_.CellCount())), 
+	body_(snake_count * capacity_), 
+	head_slot_(snake_count), 
+	length_(snake_count), 
+	direction_(snake_count, Direction::RIGHT), 
+	target_(snake_count, -1), 
+	fate_(snake_count, Fate::DIE), 
+	alive_(snake_count), 
+	rng_(snake_count), 
+	pool_(std::make_unique<WorkStealingPool>(thread_count)), 
+	chunk_size_(std::max(min_chunk_size, snake_count / (pool_->WorkerCount() * chunks_per_worker) + 1)), 
+	mt_(seed), 
+	tick_(0), 
+	alive_count_(0), 
+	food_count_(0), 
+	deaths_(0), 
+	food_eaten_(0)
+{
+	const std::size_t chunk_count = (snake_count + chunk_size_ - 1) / chunk_size_;
+	chunk_eaten_.resize(chunk_count);
+	chunk_deaths_.resize(chunk_count);
+	chunk_food_.resize(chunk_count);
+
+	for (std::size_t i = 0; i < grid_.CellCount(); ++i)
+	{
+		claims_[i].store(0, std::memory_order_relaxed);
+	}
+
+	for (std::size_t snake = 0; snake < snake_count; ++snake)
+	{
+		rng_[snake] = mt_();
+		alive_count_ += SpawnSnake(snake) ? 1 : 0;
+	}
+
+	SpawnFood();
+}
+
+template <typename Phase>
+void Arena::ForEachChunk(Phase phase)
+{
+	const std::size_t snake_count = length_.size();
+
+	pool_->Run(chunk_eaten_.size(), [this, &phase, snake_count](std::size_t chunk, std::size_t)
+	{
+		const std::size_t last = std::min(snake_count, (chunk + 1) * chunk_size_);
+
+		for (std::size_t snake = chunk * chunk_size_; snake < last; ++snake)
+		{
+			if (alive_[snake])
+			{
+				phase(snake, chunk);
+			}
+		}
+	});
+}
+
+void Arena::Tick()
+{
+	std::fill(chunk_eaten_.begin(), chunk_eaten_.end(), 0);
+	std::fill(chunk_deaths_.begin(), chunk_deaths_.end(), 0);
+	std::fill(chunk_food_.begin(), chunk_food_.end(), 0);
+
+	ForEachChunk([this](std::size_t snake, std::size_t) { Decide(snake); });
+	ForEachChunk([this](std::size_t snake, std::size_t chunk) { Resolve(snake, chunk); });
+	ForEachChunk([this](std::size_t snake, std::size_t chunk) { Apply(snake, chunk); });
+
+	for (std::size_t chunk = 0; chunk < chunk_eaten_.size(); ++chunk)
+	{
+		food_eaten_ += chunk_eaten_[chunk];
+		deaths_ += chunk_deaths_[chunk];
+		alive_count_ -= chunk_deaths_[chunk];
+		food_count_ = food_count_ + chunk_food_[chunk] - chunk_eaten_[chunk];
+	}
+
+	// Dead snakes come back in index order, so placement follows the same random sequence every run.
+	for (std::size_t snake = 0; snake < length_.size(); ++snake)
+	{
+		if (!alive_[snake] && SpawnSnake(snake))
+		{
+			++alive_count_;
+		}
+	}
+
+	SpawnFood();
+	++tick_;
+}
+
+void Arena::Decide(std::size_t snake)
+{
+	const int head = body_[snake * capacity_ + head_slot_[snake]];
+	const Direction heading = direction_[snake];
+	std::uint64_t random = NextRandom(rng_[snake]);
+
+	int best_index = -1;
+	int best_score = -1;
+
+	// Food first, then room to move on from the cell, then going straight, with random tie breaks. Only
+	// the board as it was at the start of the tick is read.
+	for (Direction direction : directions)
+	{
+		const int neighbour = grid_.Neighbour(head, direction, true);
+
+		if (cells_[neighbour] >= 0)
+		{
+			continue;
+		}
+
+		int score = cells_[neighbour] == food_cell ? 64 : 0;
+
+		for (Direction onward : directions)
+		{
+			score += cells_[grid_.Neighbour(neighbour, onward, true)] >= 0 ? 0 : 8;
+		}
+
+		score += direction == heading ? 4 : 0;
+		score += static_cast<int>(random & 7);
+		random >>= 3;
+
+		if (score > best_score)
+		{
+			best_index = neighbour;
+			best_score = score;
+			direction_[snake] = direction;
+		}
+	}
+
+	target_[snake] = best_index;
+
+	if (best_index != -1)
+	{
+		claims_[best_index].fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void Arena::Resolve(std::size_t snake, std::size_t chunk)
+{
+	const int target = target_[snake];
+
+	// Head-on: every snake heading into the same cell dies.
+	if (target == -1 || claims_[target].load(std::memory_order_relaxed) > 1)
+	{
+		fate_[snake] = Fate::DIE;
+		++chunk_deaths_[chunk];
+	}
+	else if (cells_[target] == food_cell)
+	{
+		fate_[snake] = Fate::EAT;
+		++chunk_eaten_[chunk];
+	}
+	else
+	{
+		fate_[snake] = Fate::MOVE;
+	}
+}
+
+void Arena::Apply(std::size_t snake, std::size_t chunk)
+{
+	const int target = target_[snake];
+	const std::size_t base = snake * capacity_;
+
+	// Targets were free or food at the start of the tick, so they never overlap the tails and bodies
+	// written here by other snakes. Contenders for a cell all reset its claim to the same value.
+	if (target != -1)
+	{
+		claims_[target].store(0, std::memory_order_relaxed);
+	}
+
+	if (fate_[snake] == Fate::DIE)
+	{
+		// Every other cell of the body turns into food.
+		for (std::size_t i = 0; i < length_[snake]; ++i)
+		{
+			const int cell = Segment(snake, i);
+			cells_[cell] = i % 2 == 0 ? food_cell : empty_cell;
+			chunk_food_[chunk] += i % 2 == 0 ? 1 : 0;
+		}
+
+		alive_[snake] = 0;
+		length_[snake] = 0;
+		return;
+	}
+
+	const bool grows = fate_[snake] == Fate::EAT && length_[snake] < capacity_;
+
+	if (!grows)
+	{
+		cells_[Segment(snake, length_[snake] - 1)] = empty_cell;
+	}
+	else
+	{
+		++length_[snake];
+	}
+
+	head_slot_[snake] = static_cast<std::uint32_t>((head_slot_[snake] + 1) % capacity_);
+	body_[base + head_slot_[snake]] = target;
+	cells_[target] = static_cast<std::int32_t>(snake);
+}
+
+bool Arena::SpawnSnake(std::size_t snake)
+{
+	const int columns = grid_.Columns();
+
+	// A straight horizontal body with the head on the right, on the first free stretch a probe finds.
+	for (int attempt = 0; attempt < spawn_attempts; ++attempt)
+	{
+		const int head = static_cast<int>(mt_() % grid_.CellCount());
+		const int row_start = head - head % columns;
+		bool free = static_cast<std::size_t>(columns) >= spawn_length_;
+
+		for (std::size_t i = 0; i < spawn_length_ && free; ++i)
+		{
+			free = cells_[row_start + (head - row_start - static_cast<int>(i) + columns * 2) % columns] == empty_cell;
+		}
+
+		if (!free)
+		{
+			continue;
+		}
+
+		for (std::size_t i = 0; i < spawn_length_; ++i)
+		{
+			const int cell = row_start + (head - row_start - static_cast<int>(i) + columns * 2) % columns;
+			body_[snake * capacity_ + (spawn_length_ - 1 - i)] = cell;
+			cells_[cell] = static_cast<std::int32_t>(snake);
+		}
+
+		head_slot_[snake] = static_cast<std::uint32_t>(spawn_length_ - 1);
+		length_[snake] = static_cast<std::uint32_t>(spawn_length_);
+		direction_[snake] = Direction::RIGHT;
+		alive_[snake] = 1;
+
+		return true;
+	}
+
+	return false;
+}
+
+void Arena::SpawnFood()
+{
+	for (int attempt = 0; food_count_ < food_target_ && attempt < spawn_attempts * 16; ++attempt)
+	{
+		const std::size_t cell = mt_() % grid_.CellCount();
+
+		if (cells_[cell] == empty_cell)
+		{
+			cells_[cell] = food_cell;
+			++food_count_;
+		}
+	}
+}
+
+const Grid& Arena::GetGrid() const
+{
+	return grid_;
+}
+
+std::size_t Arena::SnakeCount() const
+{
+	return length_.size();
+}
+
+std::size_t Arena::AliveCount() const
+{
+	return alive_count_;
+}
+
+bool Arena::Alive(std::size_t snake) const
+{
+	return alive_[snake] != 0;
+}
+
+std::size_t Arena::Length(std::size_t snake) const
+{
+	return length_[snake];
+}
+
+int Arena::Owner(int index) const
+{
+	return std::max(cells_[index], empty_cell);
+}
+
+bool Arena::IsFood(int index) const
+{
+	return cells_[index] == food_cell;
+}
+
+std::uint64_t Arena::Ticks() const
+{
+	return tick_;
+}
+
+std::uint64_t Arena::Deaths() const
+{
+	return deaths_;
+}
+
+std::uint64_t Arena::FoodEaten() const
+{
+	return food_eaten_;
+}
+
+std::uint64_t Arena::Checksum() const
+{
+	std::uint64_t hash = 0xcbf29ce484222325ULL;
+
+	for (std::int32_t cell : cells_)
+	{
+		hash = HashCombine(hash, static_cast<std::uint32_t>(cell));
+	}
+
+	for (std::size_t snake = 0; snake < length_.size(); ++snake)
+	{
+		hash = HashCombine(hash, length_[snake]);
+		hash = HashCombine(hash, length_[snake] > 0 ? static_cast<std::uint32_t>(Segment(snake, 0)) : 0);
+	}
+
+	return hash;
+}
\ No newline at end of file
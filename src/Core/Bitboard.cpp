@@ -0,0 +1,65 @@
+#include "Core/Bitboard.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+Bitboard::Bitboard(std::size_t size) : size_(size), words_((size + 63) / 64, 0)
+{
+}
+
+void Bitboard::Resize(std::size_t size)
+{
+	size_ = size;
+	words_.assign((size + 63) / 64, 0);
+}
+
+void Bitboard::Clear()
+{
+	std::fill(words_.begin(), words_.end(), 0);
+}
+
+std::size_t Bitboard::Size() const
+{
+	return size_;
+}
+
+std::size_t Bitboard::Count() const
+{
+	std::size_t count = 0;
+
+	for (std::uint64_t word : words_)
+	{
+		count += std::bitset<64>(word).count();
+	}
+
+	return count;
+}
+
+const std::vector<std::uint64_t>& Bitboard::Words() const
+{
+	return words_;
+}
+
+std::vector<std::uint64_t>& Bitboard::MutableWords()
+{
+	return words_;
+}
+
+void Bitboard::AssignComplement(const Bitboard& other)
+{
+	size_ = other.size_;
+	words_.resize(other.words_.size());
+
+	for (std::size_t i = 0; i < words_.size(); ++i)
+	{
+		words_[i] = ~other.words_[i];
+	}
+
+	// Keep the bits past the last cell clear.
+	if (size_ % 64 != 0)
+	{
+		words_.back() &= (std::uint64_t{ 1 } << (size_ % 64)) - 1;
+	}
+}
\ No newline at end of file
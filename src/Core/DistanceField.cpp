@@ -0,0 +1,93 @@
+#include "Core/DistanceField.hpp"
+#include "Core/Bitboard.hpp"
+#include "Core/Grid.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+DistanceField::DistanceField() : source_(-1), wrapped_(false)
+{
+}
+
+void DistanceField::Compute(const Grid& grid, const Bitboard& blocked, int source, bool wrapped)
+{
+	distance_.assign(grid.CellCount(), unreachable);
+	queue_.clear();
+	queue_.reserve(grid.CellCount());
+
+	source_ = source;
+	wrapped_ = wrapped;
+
+	distance_[source] = 0;
+	queue_.push_back(source);
+	Propagate(grid, blocked);
+}
+
+void DistanceField::Release(const Grid& grid, const Bitboard& blocked, int index)
+{
+	if (Empty() || blocked.Test(index))
+	{
+		return;
+	}
+
+	int best_distance = index == source_ ? 0 : unreachable;
+
+	for (int neighbour_index : grid.Neighbours(index, wrapped_))
+	{
+		if (!blocked.Test(neighbour_index) && distance_[neighbour_index] != unreachable)
+		{
+			best_distance = std::min(best_distance, distance_[neighbour_index] + 1);
+		}
+	}
+
+	if (best_distance >= distance_[index])
+	{
+		return;
+	}
+
+	distance_[index] = best_distance;
+	queue_.clear();
+	queue_.push_back(index);
+	Propagate(grid, blocked);
+}
+
+void DistanceField::Propagate(const Grid& grid, const Bitboard& blocked)
+{
+	// Entries are appended in non-decreasing distance order, so every cell is settled the first time it is lowered.
+	for (std::size_t i = 0; i < queue_.size(); ++i)
+	{
+		const int index = queue_[i];
+		const int next_distance = distance_[index] + 1;
+
+		for (int neighbour_index : grid.Neighbours(index, wrapped_))
+		{
+			if (!blocked.Test(neighbour_index) && next_distance < distance_[neighbour_index])
+			{
+				distance_[neighbour_index] = next_distance;
+				queue_.push_back(neighbour_index);
+			}
+		}
+	}
+}
+
+void DistanceField::Invalidate()
+{
+	distance_.clear();
+	source_ = -1;
+}
+
+bool DistanceField::Empty() const
+{
+	return distance_.empty();
+}
+
+int DistanceField::Source() const
+{
+	return source_;
+}
+
+bool DistanceField::Wrapped() const
+{
+	return wrapped_;
+}
\ No newline at end of file
@@ -0,0 +1,198 @@
+#include "Core/FloodFill.hpp"
+#include "Core/Bitboard.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+	// Spreads the seeds towards higher bits through runs of propagators.
+	std::uint64_t OccludedFillUp(std::uint64_t seeds, std::uint64_t propagators)
+	{
+		seeds |= propagators & (seeds << 1);
+		propagators &= propagators << 1;
+		seeds |= propagators & (seeds << 2);
+		propagators &= propagators << 2;
+		seeds |= propagators & (seeds << 4);
+		propagators &= propagators << 4;
+		seeds |= propagators & (seeds << 8);
+		propagators &= propagators << 8;
+		seeds |= propagators & (seeds << 16);
+		propagators &= propagators << 16;
+		seeds |= propagators & (seeds << 32);
+
+		return seeds;
+	}
+
+	std::uint64_t OccludedFillDown(std::uint64_t seeds, std::uint64_t propagators)
+	{
+		seeds |= propagators & (seeds >> 1);
+		propagators &= propagators >> 1;
+		seeds |= propagators & (seeds >> 2);
+		propagators &= propagators >> 2;
+		seeds |= propagators & (seeds >> 4);
+		propagators &= propagators >> 4;
+		seeds |= propagators & (seeds >> 8);
+		propagators &= propagators >> 8;
+		seeds |= propagators & (seeds >> 16);
+		propagators &= propagators >> 16;
+		seeds |= propagators & (seeds >> 32);
+
+		return seeds;
+	}
+} // namespace
+
+FloodFill::FloodFill(int columns, int rows) : 
+	columns_(columns), 
+	rows_(rows), 
+	first_column_(static_cast<std::size_t>(columns) * rows), 
+	last_column_(static_cast<std::size_t>(columns) * rows)
+{
+	for (int y = 0; y < rows; ++y)
+	{
+		first_column_.Set(y * columns);
+		last_column_.Set(y * columns + columns - 1);
+	}
+}
+
+bool FloodFill::FillRows(const Bitboard& open, Bitboard& region) const
+{
+	const std::vector<std::uint64_t>& open_words = open.Words();
+	const std::vector<std::uint64_t>& first_words = first_column_.Words();
+	const std::vector<std::uint64_t>& last_words = last_column_.Words();
+	std::vector<std::uint64_t>& words = region.MutableWords();
+	bool changed = false;
+
+	// Towards higher indices: a cell can be entered from its left unless it starts a row.
+	std::uint64_t carry = 0;
+
+	for (std::size_t i = 0; i < words.size(); ++i)
+	{
+		const std::uint64_t propagators = open_words[i] & ~first_words[i];
+		const std::uint64_t filled = OccludedFillUp(words[i] | (carry & propagators), propagators);
+
+		carry = filled >> 63;
+		changed |= filled != words[i];
+		words[i] = filled;
+	}
+
+	// Towards lower indices: a cell can be entered from its right unless it ends a row.
+	carry = 0;
+
+	for (std::size_t i = words.size(); i-- > 0;)
+	{
+		const std::uint64_t propagators = open_words[i] & ~last_words[i];
+		const std::uint64_t filled = OccludedFillDown(words[i] | ((carry << 63) & propagators), propagators);
+
+		carry = filled & 1;
+		changed |= filled != words[i];
+		words[i] = filled;
+	}
+
+	return changed;
+}
+
+bool FloodFill::FillColumns(const Bitboard& open, Bitboard& region) const
+{
+	const std::vector<std::uint64_t>& open_words = open.Words();
+	std::vector<std::uint64_t>& words = region.MutableWords();
+	const std::size_t word_count = words.size();
+	const std::size_t word_shift = static_cast<std::size_t>(columns_) / 64;
+	const int bit_shift = columns_ % 64;
+	bool changed = false;
+
+	// Downwards, in place and in increasing order so that one sweep carries a fill down a whole column. When
+	// a row is shorter than a word the shift stays inside the word and has to be repeated.
+	for (std::size_t i = word_shift; i < word_count; ++i)
+	{
+		while (true)
+		{
+			const std::uint64_t near = words[i - word_shift];
+			const std::uint64_t far = i > word_shift ? words[i - word_shift - 1] : 0;
+			const std::uint64_t from_above = bit_shift == 0 ? near : (near << bit_shift) | (far >> (64 - bit_shift));
+			const std::uint64_t filled = words[i] | (from_above & open_words[i]);
+
+			if (filled == words[i])
+			{
+				break;
+			}
+
+			words[i] = filled;
+			changed = true;
+		}
+	}
+
+	// Upwards, in decreasing order.
+	for (std::size_t i = word_count - word_shift; i-- > 0;)
+	{
+		while (true)
+		{
+			const std::uint64_t near = words[i + word_shift];
+			const std::uint64_t far = i + word_shift + 1 < word_count ? words[i + word_shift + 1] : 0;
+			const std::uint64_t from_below = bit_shift == 0 ? near : (near >> bit_shift) | (far << (64 - bit_shift));
+			const std::uint64_t filled = words[i] | (from_below & open_words[i]);
+
+			if (filled == words[i])
+			{
+				break;
+			}
+
+			words[i] = filled;
+			changed = true;
+		}
+	}
+
+	return changed;
+}
+
+bool FloodFill::FillEdges(const Bitboard& open, Bitboard& region) const
+{
+	bool changed = false;
+
+	auto spread = [&open, &region, &changed](int from_index, int to_index)
+	{
+		if (region.Test(from_index) && !region.Test(to_index) && open.Test(to_index))
+		{
+			region.Set(to_index);
+			changed = true;
+		}
+	};
+
+	for (int y = 0; y < rows_; ++y)
+	{
+		spread(y * columns_ + columns_ - 1, y * columns_);
+		spread(y * columns_, y * columns_ + columns_ - 1);
+	}
+
+	const int last_row = (rows_ - 1) * columns_;
+
+	for (int x = 0; x < columns_; ++x)
+	{
+		spread(last_row + x, x);
+		spread(x, last_row + x);
+	}
+
+	return changed;
+}
+
+bool FloodFill::Fill(const Bitboard& open, Bitboard& region, bool wrapped, int target_index) const
+{
+	while (target_index == -1 || !region.Test(target_index))
+	{
+		bool changed = FillRows(open, region);
+		changed |= FillColumns(open, region);
+
+		if (wrapped)
+		{
+			changed |= FillEdges(open, region);
+		}
+
+		if (!changed)
+		{
+			return target_index == -1;
+		}
+	}
+
+	return true;
+}
\ No newline at end of file
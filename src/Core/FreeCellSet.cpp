@@ -0,0 +1,136 @@
+#include "Core/FreeCellSet.hpp"
+
+#include <bitset>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+FreeCellSet::FreeCellSet(std::size_t capacity) : tree_words_(0), size_(0)
+{
+	Fill(capacity);
+}
+
+void FreeCellSet::Fill(std::size_t capacity)
+{
+	const std::size_t word_count = (capacity + 63) / 64;
+
+	words_.assign(word_count, ~std::uint64_t{ 0 });
+
+	if (capacity % 64 != 0)
+	{
+		words_.back() = (std::uint64_t{ 1 } << (capacity % 64)) - 1;
+	}
+
+	// The tree covers a power of two of words, the ones past the end empty, so that the k-th member search
+	// needs no bounds checks. Built in O(n) by pushing each node's total into its parent.
+	tree_words_ = 1;
+
+	while (tree_words_ < word_count)
+	{
+		tree_words_ *= 2;
+	}
+
+	counts_.assign(tree_words_ + 1, 0);
+
+	for (std::size_t i = 1; i <= tree_words_; ++i)
+	{
+		counts_[i] += i <= word_count ? static_cast<std::uint32_t>(std::bitset<64>(words_[i - 1]).count()) : 0;
+
+		const std::size_t parent = i + (i & (~i + 1));
+
+		if (parent <= tree_words_)
+		{
+			counts_[parent] += counts_[i];
+		}
+	}
+
+	size_ = capacity;
+}
+
+void FreeCellSet::AddToWord(std::size_t word, int delta)
+{
+	for (std::size_t i = word + 1; i < counts_.size(); i += i & (~i + 1))
+	{
+		counts_[i] += static_cast<std::uint32_t>(delta);
+	}
+}
+
+void FreeCellSet::Insert(int index)
+{
+	if (Contains(index))
+	{
+		return;
+	}
+
+	const std::size_t word = static_cast<std::size_t>(index) >> 6;
+
+	words_[word] |= std::uint64_t{ 1 } << (index & 63);
+	AddToWord(word, 1);
+	++size_;
+}
+
+void FreeCellSet::Erase(int index)
+{
+	if (!Contains(index))
+	{
+		return;
+	}
+
+	const std::size_t word = static_cast<std::size_t>(index) >> 6;
+
+	words_[word] &= ~(std::uint64_t{ 1 } << (index & 63));
+	AddToWord(word, -1);
+	--size_;
+}
+
+bool FreeCellSet::Empty() const
+{
+	return size_ == 0;
+}
+
+std::size_t FreeCellSet::Size() const
+{
+	return size_;
+}
+
+int FreeCellSet::At(std::size_t position) const
+{
+	assert(position < size_);
+
+	// Descends the tree to the last word whose preceding words hold no more than position members.
+	std::size_t word = 0;
+
+	for (std::size_t step = tree_words_ / 2; step > 0; step /= 2)
+	{
+		if (counts_[word + step] <= position)
+		{
+			word += step;
+			position -= counts_[word];
+		}
+	}
+
+	// Then finds the byte holding the member from the running member counts of the word's bytes, and the bit
+	// within it.
+	const std::uint64_t bytes = 0x0101010101010101ULL;
+	const std::uint64_t bits = words_[word];
+	std::uint64_t byte_counts = bits - ((bits >> 1) & 0x5555555555555555ULL);
+	byte_counts = (byte_counts & 0x3333333333333333ULL) + ((byte_counts >> 2) & 0x3333333333333333ULL);
+	byte_counts = (byte_counts + (byte_counts >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+
+	const std::uint64_t running_counts = byte_counts * bytes;
+	const std::uint64_t bytes_before = ((((position * bytes) | (bytes << 7)) - running_counts) & (bytes << 7)) >> 7;
+	const std::size_t offset = static_cast<std::size_t>((bytes_before * bytes) >> 56) * 8;
+
+	position -= static_cast<std::size_t>(((running_counts << 8) >> offset) & 0xff);
+
+	std::uint64_t byte = (bits >> offset) & 0xff;
+
+	for (; position > 0; --position)
+	{
+		byte &= byte - 1;
+	}
+
+	// The bits below the lowest one left count its offset in the byte.
+	return static_cast<int>(word * 64 + offset + std::bitset<8>((byte & (~byte + 1)) - 1).count());
+}
\ No newline at end of file
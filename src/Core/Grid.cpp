@@ -0,0 +1,24 @@
+#include "Core/Grid.hpp"
+
+#include <cassert>
+#include <cstddef>
+
+Grid::Grid(int columns, int rows) : columns_(columns), rows_(rows), neighbours_(columns, rows)
+{
+	assert(columns > 0 && rows > 0);
+}
+
+int Grid::Columns() const
+{
+	return columns_;
+}
+
+int Grid::Rows() const
+{
+	return rows_;
+}
+
+std::size_t Grid::CellCount() const
+{
+	return static_cast<std::size_t>(columns_) * rows_;
+}
\ No newline at end of file
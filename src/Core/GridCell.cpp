@@ -0,0 +1,15 @@
+#include "Core/GridCell.hpp"
+
+#include <cmath>
+
+GridCell::GridCell(int x, int y) : x_(x), y_(y)
+{
+}
+
+int GridCell::GetXYDistance(const GridCell& target_cell) const
+{
+	const int x_distance = std::abs(target_cell.x_ - x_);
+	const int y_distance = std::abs(target_cell.y_ - y_);
+
+	return x_distance + y_distance;
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "Core/HamiltonianCycle.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+HamiltonianCycle::HamiltonianCycle()
+{
+}
+
+bool HamiltonianCycle::Exists(int columns, int rows)
+{
+	return columns >= 2 && rows >= 2 && (rows % 2 == 0 || columns % 2 == 0);
+}
+
+bool HamiltonianCycle::Build(int columns, int rows)
+{
+	order_.clear();
+	cells_.clear();
+
+	if (!Exists(columns, rows))
+	{
+		return false;
+	}
+
+	// Lay the serpentine out along lanes of lane_length cells; lanes are rows unless that leaves an odd count.
+	const bool transposed = rows % 2 != 0;
+	const int lane_count = transposed ? columns : rows;
+	const int lane_length = transposed ? rows : columns;
+
+	auto cell_index = [columns, transposed](int lane, int position)
+	{
+		return transposed ? position * columns + lane : lane * columns + position;
+	};
+
+	cells_.reserve(static_cast<std::size_t>(columns) * rows);
+
+	for (int lane = 0; lane < lane_count; ++lane)
+	{
+		for (int i = 1; i < lane_length; ++i)
+		{
+			const int position = lane % 2 == 0 ? i : lane_length - i;
+			cells_.push_back(cell_index(lane, position));
+		}
+	}
+
+	for (int lane = lane_count - 1; lane >= 0; --lane)
+	{
+		cells_.push_back(cell_index(lane, 0));
+	}
+
+	// Rotate so that the tour starts at the first cell of the grid.
+	std::rotate(cells_.begin(), cells_.end() - 1, cells_.end());
+
+	order_.resize(cells_.size());
+
+	for (std::size_t i = 0; i < cells_.size(); ++i)
+	{
+		order_[cells_[i]] = static_cast<int>(i);
+	}
+
+	return true;
+}
+
+bool HamiltonianCycle::Empty() const
+{
+	return cells_.empty();
+}
+
+void HamiltonianCycle::Reverse()
+{
+	std::reverse(cells_.begin(), cells_.end());
+
+	for (std::size_t i = 0; i < cells_.size(); ++i)
+	{
+		order_[cells_[i]] = static_cast<int>(i);
+	}
+}
+
+bool HamiltonianCycle::Reversed() const
+{
+	// Build always starts the tour at cell 0.
+	return !cells_.empty() && cells_[0] != 0;
+}
\ No newline at end of file
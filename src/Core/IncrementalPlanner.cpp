@@ -0,0 +1,259 @@
+#include "Core/IncrementalPlanner.hpp"
+#include "Core/Grid.hpp"
+#include "Core/Simulation.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace
+{
+	constexpr int infinity = std::numeric_limits<int>::max() / 4;
+} // namespace
+
+IncrementalPlanner::IncrementalPlanner() : 
+	simulation_(nullptr), 
+	valid_(false), 
+	wrapped_(false), 
+	start_(-1), 
+	last_start_(-1), 
+	goal_(-1), 
+	key_modifier_(0), 
+	synced_step_(0)
+{
+}
+
+void IncrementalPlanner::Invalidate()
+{
+	valid_ = false;
+	path_.clear();
+}
+
+bool IncrementalPlanner::Plan(const Simulation& simulation, bool wrapped)
+{
+	if (simulation.Food() == -1)
+	{
+		Invalidate();
+		return false;
+	}
+
+	const int start = simulation.GetSnake().GetHead();
+	const int goal = simulation.Food();
+
+	const bool stale = !valid_ || simulation_ != &simulation || wrapped_ != wrapped || goal_ != goal || synced_step_ + 1 != simulation.Steps();
+
+	simulation_ = &simulation;
+	wrapped_ = wrapped;
+	goal_ = goal;
+	start_ = start;
+	synced_step_ = simulation.Steps();
+
+	if (stale)
+	{
+		Initialize();
+	}
+	else if (start_ != last_start_)
+	{
+		// The previous head is now part of the body and the vacated tail cell is open again.
+		key_modifier_ += Heuristic(last_start_, start_);
+		UpdateVertexAndNeighbours(last_start_);
+
+		if (simulation.ReleasedCell() != -1)
+		{
+			UpdateVertexAndNeighbours(simulation.ReleasedCell());
+		}
+	}
+
+	last_start_ = start_;
+	ComputeShortestPath();
+
+	return ExtractPath();
+}
+
+const std::vector<int>& IncrementalPlanner::Path() const
+{
+	return path_;
+}
+
+void IncrementalPlanner::Initialize()
+{
+	const std::size_t cell_count = simulation_->GetGrid().CellCount();
+
+	g_.assign(cell_count, infinity);
+	rhs_.assign(cell_count, infinity);
+	open_keys_.assign(cell_count, Key{ infinity, infinity });
+	in_open_.assign(cell_count, false);
+	open_ = decltype(open_)();
+
+	key_modifier_ = 0;
+	rhs_[goal_] = 0;
+	open_keys_[goal_] = CalculateKey(goal_);
+	in_open_[goal_] = true;
+	open_.push({ open_keys_[goal_], goal_ });
+
+	valid_ = true;
+}
+
+bool IncrementalPlanner::IsBlocked(int index) const
+{
+	return index != start_ && simulation_->IsOccupied(index);
+}
+
+int IncrementalPlanner::Heuristic(int from_index, int to_index) const
+{
+	return simulation_->GetGrid().Distance(from_index, to_index, wrapped_);
+}
+
+IncrementalPlanner::Key IncrementalPlanner::CalculateKey(int index) const
+{
+	const int min_cost = std::min(g_[index], rhs_[index]);
+
+	if (min_cost >= infinity)
+	{
+		return { infinity, infinity };
+	}
+
+	return { min_cost + Heuristic(start_, index) + key_modifier_, min_cost };
+}
+
+void IncrementalPlanner::UpdateVertex(int index)
+{
+	if (index != goal_)
+	{
+		int best_cost = infinity;
+
+		if (!IsBlocked(index))
+		{
+			for (int neighbour_index : simulation_->GetGrid().Neighbours(index, wrapped_))
+			{
+				if (!IsBlocked(neighbour_index))
+				{
+					best_cost = std::min(best_cost, g_[neighbour_index] + 1);
+				}
+			}
+		}
+
+		rhs_[index] = std::min(best_cost, infinity);
+	}
+
+	if (g_[index] != rhs_[index])
+	{
+		const Key key = CalculateKey(index);
+
+		if (!in_open_[index] || open_keys_[index] != key)
+		{
+			open_keys_[index] = key;
+			in_open_[index] = true;
+			open_.push({ key, index });
+		}
+	}
+	else
+	{
+		in_open_[index] = false;
+	}
+}
+
+void IncrementalPlanner::UpdateVertexAndNeighbours(int index)
+{
+	UpdateVertex(index);
+
+	for (int neighbour_index : simulation_->GetGrid().Neighbours(index, wrapped_))
+	{
+		UpdateVertex(neighbour_index);
+	}
+}
+
+bool IncrementalPlanner::PopOpen(OpenEntry& entry)
+{
+	// Entries are never removed in place; anything that no longer matches the cell's current key is stale.
+	while (!open_.empty())
+	{
+		const OpenEntry& top = open_.top();
+
+		if (in_open_[top.index_] && open_keys_[top.index_] == top.key_)
+		{
+			entry = top;
+			return true;
+		}
+
+		open_.pop();
+	}
+
+	return false;
+}
+
+void IncrementalPlanner::ComputeShortestPath()
+{
+	OpenEntry entry;
+
+	while (PopOpen(entry) && (entry.key_ < CalculateKey(start_) || rhs_[start_] != g_[start_]))
+	{
+		const int index = entry.index_;
+		const Key new_key = CalculateKey(index);
+
+		open_.pop();
+		in_open_[index] = false;
+
+		if (entry.key_ < new_key)
+		{
+			open_keys_[index] = new_key;
+			in_open_[index] = true;
+			open_.push({ new_key, index });
+		}
+		else if (g_[index] > rhs_[index])
+		{
+			g_[index] = rhs_[index];
+
+			for (int neighbour_index : simulation_->GetGrid().Neighbours(index, wrapped_))
+			{
+				UpdateVertex(neighbour_index);
+			}
+		}
+		else
+		{
+			g_[index] = infinity;
+			UpdateVertexAndNeighbours(index);
+		}
+	}
+}
+
+bool IncrementalPlanner::ExtractPath()
+{
+	path_.clear();
+
+	if (g_[start_] >= infinity)
+	{
+		return false;
+	}
+
+	const std::size_t max_length = g_.size();
+	int cell = start_;
+
+	while (cell != goal_)
+	{
+		int next_cell = -1;
+		int next_cost = infinity;
+
+		for (int neighbour_index : simulation_->GetGrid().Neighbours(cell, wrapped_))
+		{
+			if (!IsBlocked(neighbour_index) && g_[neighbour_index] < next_cost)
+			{
+				next_cell = neighbour_index;
+				next_cost = g_[neighbour_index];
+			}
+		}
+
+		if (next_cell == -1 || path_.size() == max_length)
+		{
+			path_.clear();
+			return false;
+		}
+
+		path_.push_back(next_cell);
+		cell = next_cell;
+	}
+
+	std::reverse(path_.begin(), path_.end());
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,254 @@
+#include "Core/MonteCarloPlanner.hpp"
+#include "Core/Direction.hpp"
+#include "Core/Grid.hpp"
+#include "Core/Simulation.hpp"
+#include "Utils/WorkStealingPool.hpp"
+#include "Utils/Xoshiro256.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// Food further ahead counts for less, and dying costs as much as this many foods would have gained.
+	constexpr double food_discount = 0.97;
+	constexpr double death_penalty = 10.0;
+	constexpr double win_bonus = 100.0;
+
+	// Rollouts per candidate launched together, so that the time budget is checked between rounds.
+	constexpr int rollouts_per_round = 16;
+
+	// The neck is never a move: the snake ignores a turn back and goes straight on instead. A snake of two
+	// would otherwise offer it, since its neck is also the tail that moves away.
+	bool CanEnter(const Simulation& simulation, int index)
+	{
+		const Snake& snake = simulation.GetSnake();
+
+		if (snake.Length() > 1 && index == snake.Segment(1))
+		{
+			return false;
+		}
+
+		return !simulation.IsOccupied(index) || (index == snake.GetTail() && index != simulation.Food());
+	}
+} // namespace
+
+MonteCarloPlanner::MonteCarloPlanner(std::size_t thread_count) : 
+	pool_(std::make_unique<WorkStealingPool>(thread_count)), 
+	decision_(0), 
+	rollouts_(256), 
+	depth_(64), 
+	budget_us_(0), 
+	rollouts_run_(0)
+{
+}
+
+MonteCarloPlanner::~MonteCarloPlanner() = default;
+
+std::size_t MonteCarloPlanner::ThreadCount() const
+{
+	return pool_->WorkerCount();
+}
+
+void MonteCarloPlanner::SetRollouts(int rollouts)
+{
+	rollouts_ = rollouts;
+}
+
+void MonteCarloPlanner::SetDepth(int depth)
+{
+	depth_ = depth;
+}
+
+void MonteCarloPlanner::SetTimeBudgetUs(std::int64_t budget_us)
+{
+	budget_us_ = budget_us;
+}
+
+std::uint64_t MonteCarloPlanner::RolloutsRun() const
+{
+	return rollouts_run_;
+}
+
+void MonteCarloPlanner::PrepareWorkers(const Simulation& simulation)
+{
+	const Grid& grid = simulation.GetGrid();
+
+	if (!workers_.empty() && workers_.front()->GetGrid().Columns() == grid.Columns() && workers_.front()->GetGrid().Rows() == grid.Rows())
+	{
+		return;
+	}
+
+	workers_.clear();
+	worker_decisions_.assign(pool_->WorkerCount(), 0);
+
+	for (std::size_t i = 0; i < pool_->WorkerCount(); ++i)
+	{
+		workers_.emplace_back(std::make_unique<Simulation>(grid.Columns(), grid.Rows(), 0));
+	}
+}
+
+double MonteCarloPlanner::Rollout(Simulation& simulation, const Candidate& candidate, std::uint64_t seed) const
+{
+	std::mt19937_64 mt(seed);
+	std::uniform_int_distribution<int> percent(0, 99);
+	const Grid& grid = simulation.GetGrid();
+
+	simulation.Reseed(mt());
+
+	Direction direction = candidate.direction_;
+	double value = 0.0;
+	double discount = 1.0;
+
+	for (int step = 0; step <= depth_; ++step)
+	{
+		const StepResult result = simulation.Step(direction);
+
+		if (result == StepResult::COLLIDED)
+		{
+			return value - discount * death_penalty;
+		}
+
+		if (result == StepResult::WON)
+		{
+			return value + discount * win_bonus;
+		}
+
+		if (result == StepResult::ATE_FOOD)
+		{
+			value += discount;
+		}
+
+		discount *= food_discount;
+
+		// Mostly greedy towards the food, sometimes any safe cell, so the rollouts spread over the board.
+		const int head_index = simulation.GetSnake().GetHead();
+		const int food_index = simulation.Food();
+		int options[4];
+		int option_count = 0;
+		int best_index = -1;
+		int best_distance = 0;
+
+		for (int neighbour_index : grid.Neighbours(head_index, true))
+		{
+			if (!CanEnter(simulation, neighbour_index))
+			{
+				continue;
+			}
+
+			options[option_count++] = neighbour_index;
+			const int distance = grid.Distance(neighbour_index, food_index, true);
+
+			if (best_index == -1 || distance < best_distance)
+			{
+				best_index = neighbour_index;
+				best_distance = distance;
+			}
+		}
+
+		if (option_count == 0)
+		{
+			return value - discount * death_penalty;
+		}
+
+		const int next_index = percent(mt) < 75 ? best_index : options[mt() % option_count];
+		direction = simulation.DirectionTowards(head_index, next_index);
+	}
+
+	return value;
+}
+
+Direction MonteCarloPlanner::ChooseDirection(const Simulation& simulation)
+{
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	const int head_index = simulation.GetSnake().GetHead();
+
+	rollouts_run_ = 0;
+	candidates_.clear();
+
+	for (int neighbour_index : simulation.GetGrid().Neighbours(head_index, true))
+	{
+		if (CanEnter(simulation, neighbour_index))
+		{
+			candidates_.push_back({ neighbour_index, simulation.DirectionTowards(head_index, neighbour_index) });
+		}
+	}
+
+	if (candidates_.size() < 2)
+	{
+		return candidates_.empty() ? simulation.GetSnake().GetDirection() : candidates_.front().direction_;
+	}
+
+	PrepareWorkers(simulation);
+	++decision_;
+
+	// The game's RNG only moves when food is eaten, so mix in the step as well to vary the rollouts every tick.
+	const std::uint64_t base_seed = SplitMix64(simulation.PeekRandom() ^ simulation.Steps());
+	const std::size_t candidate_count = candidates_.size();
+	values_.assign(candidate_count * rollouts_, 0.0);
+
+	// Task t plays rollout t / candidate_count of candidate t % candidate_count, so a round covers every
+	// candidate equally and each rollout's seed depends only on its own position.
+	int played = 0;
+
+	while (played < rollouts_)
+	{
+		const int round = std::min(rollouts_per_round, rollouts_ - played);
+		const std::size_t first_task = static_cast<std::size_t>(played) * candidate_count;
+
+		pool_->Run(static_cast<std::size_t>(round) * candidate_count, [this, &simulation, first_task, base_seed](std::size_t task_index, std::size_t worker_index)
+		{
+			const std::size_t rollout_index = first_task + task_index;
+			Simulation& worker = *workers_[worker_index];
+
+			if (worker_decisions_[worker_index] != decision_)
+			{
+				worker.CopyGameState(simulation);
+				worker_decisions_[worker_index] = decision_;
+			}
+
+			worker.BeginRollout();
+			values_[rollout_index] = Rollout(worker, candidates_[rollout_index % candidates_.size()], SplitMix64(base_seed ^ rollout_index));
+
+			if (!worker.EndRollout())
+			{
+				worker.CopyGameState(simulation);
+			}
+		});
+
+		played += round;
+
+		if (budget_us_ > 0 && std::chrono::steady_clock::now() - start >= std::chrono::microseconds(budget_us_))
+		{
+			break;
+		}
+	}
+
+	rollouts_run_ = static_cast<std::uint64_t>(played) * candidate_count;
+
+	std::size_t best_candidate = 0;
+	double best_value = 0.0;
+
+	for (std::size_t candidate = 0; candidate < candidate_count; ++candidate)
+	{
+		double value = 0.0;
+
+		for (int rollout = 0; rollout < played; ++rollout)
+		{
+			value += values_[static_cast<std::size_t>(rollout) * candidate_count + candidate];
+		}
+
+		if (candidate == 0 || value > best_value)
+		{
+			best_candidate = candidate;
+			best_value = value;
+		}
+	}
+
+	return candidates_[best_candidate].direction_;
+}
\ No newline at end of file
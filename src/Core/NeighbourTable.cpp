@@ -0,0 +1,63 @@
+#include "Core/NeighbourTable.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+NeighbourTable::NeighbourTable(int columns, int rows) : 
+	columns_(columns), 
+	rows_(rows), 
+	borders_(static_cast<std::size_t>(columns) * rows, 0), 
+	plain_offsets_{ -1, 1, -columns, columns }, 
+	direction_borders_{ left_border, right_border, top_border, bottom_border }, 
+	wrapped_offsets_{}
+{
+	for (int y = 0; y < rows_; ++y)
+	{
+		for (int x = 0; x < columns_; ++x)
+		{
+			std::uint8_t borders = 0;
+			borders |= x == 0 ? left_border : 0;
+			borders |= x == columns_ - 1 ? right_border : 0;
+			borders |= y == 0 ? top_border : 0;
+			borders |= y == rows_ - 1 ? bottom_border : 0;
+
+			borders_[static_cast<std::size_t>(y) * columns_ + x] = borders;
+		}
+	}
+
+	for (int borders = 0; borders < 16; ++borders)
+	{
+		std::array<int, 4>& offsets = wrapped_offsets_[borders];
+		offsets = plain_offsets_;
+
+		if (borders & left_border)
+		{
+			offsets[0] += columns_;
+		}
+
+		if (borders & right_border)
+		{
+			offsets[1] -= columns_;
+		}
+
+		if (borders & top_border)
+		{
+			offsets[2] += columns_ * rows_;
+		}
+
+		if (borders & bottom_border)
+		{
+			offsets[3] -= columns_ * rows_;
+		}
+	}
+}
+
+int NeighbourTable::Columns() const
+{
+	return columns_;
+}
+
+int NeighbourTable::Rows() const
+{
+	return rows_;
+}
\ No newline at end of file
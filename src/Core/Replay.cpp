@@ -0,0 +1,160 @@
+#include "Core/Replay.hpp"
+#include "Core/Direction.hpp"
+#include "Core/Simulation.hpp"
+#include "Utils/BinaryReader.hpp"
+#include "Utils/BinaryWriter.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	constexpr char replay_magic[4] = { 'S', 'N', 'K', 'R' };
+	constexpr std::uint8_t replay_version = 2;
+} // namespace
+
+Replay::Replay(int columns, int rows, std::uint64_t seed) : columns_(columns), rows_(rows), seed_(seed), step_count_(0)
+{
+}
+
+void Replay::RecordTurn(Direction direction)
+{
+	events_.push_back({ step_count_, ReplayEventType::TURN, static_cast<std::uint8_t>(direction) });
+}
+
+void Replay::RecordAutopilot(bool enabled, AutopilotMode autopilot_mode)
+{
+	const std::uint8_t value = !enabled ? 0 : static_cast<std::uint8_t>(autopilot_mode) + 1;
+	events_.push_back({ step_count_, ReplayEventType::AUTOPILOT, value });
+}
+
+void Replay::RecordReset()
+{
+	events_.push_back({ step_count_, ReplayEventType::RESET, 0 });
+}
+
+void Replay::RecordStep()
+{
+	++step_count_;
+}
+
+bool Replay::Save(const std::string& path) const
+{
+	std::vector<std::uint8_t> bytes;
+	BinaryWriter writer(bytes);
+
+	writer.WriteBytes(replay_magic, sizeof(replay_magic));
+	writer.WriteUint(replay_version, 1);
+	writer.WriteUint(static_cast<std::uint32_t>(columns_), 4);
+	writer.WriteUint(static_cast<std::uint32_t>(rows_), 4);
+	writer.WriteUint(seed_, 8);
+	writer.WriteUint(step_count_, 8);
+	writer.WriteUint(events_.size(), 8);
+
+	std::uint64_t last_step = 0;
+
+	for (const ReplayEvent& event : events_)
+	{
+		writer.WriteVarint(event.step_ - last_step);
+		writer.WriteUint(static_cast<std::uint8_t>(event.type_) << 4 | event.value_, 1);
+		last_step = event.step_;
+	}
+
+	return BinaryWriter::WriteFile(path, bytes);
+}
+
+bool Replay::Load(const std::string& path)
+{
+	std::vector<std::uint8_t> bytes;
+
+	if (!BinaryReader::ReadFile(path, bytes))
+	{
+		return false;
+	}
+
+	BinaryReader reader(bytes.data(), bytes.size());
+	char magic[4] = {};
+	std::uint64_t version = 0;
+	std::uint64_t columns = 0;
+	std::uint64_t rows = 0;
+	std::uint64_t seed = 0;
+	std::uint64_t step_count = 0;
+	std::uint64_t event_count = 0;
+
+	if (!reader.ReadBytes(magic, sizeof(magic)) || !std::equal(magic, magic + 4, replay_magic) || !reader.ReadUint(version, 1) 
+		|| version != replay_version || !reader.ReadUint(columns, 4) || !reader.ReadUint(rows, 4) || !reader.ReadUint(seed, 8) 
+		|| !reader.ReadUint(step_count, 8) || !reader.ReadUint(event_count, 8) || event_count > reader.Remaining())
+	{
+		printf("%s is not a replay file!\n", path.c_str());
+		return false;
+	}
+
+	std::vector<ReplayEvent> events;
+	events.reserve(event_count);
+
+	std::uint64_t step = 0;
+
+	for (std::uint64_t i = 0; i < event_count; ++i)
+	{
+		std::uint64_t delta = 0;
+		std::uint64_t byte = 0;
+
+		if (!reader.ReadVarint(delta) || !reader.ReadUint(byte, 1))
+		{
+			printf("%s is truncated!\n", path.c_str());
+			return false;
+		}
+
+		// Only values that Record* can write are cast into the enums.
+		const std::uint64_t type = byte >> 4;
+		const std::uint64_t value = byte & 0x0F;
+		const std::uint64_t max_value = type == static_cast<std::uint64_t>(ReplayEventType::TURN) ? static_cast<std::uint64_t>(Direction::DOWN) 
+			: type == static_cast<std::uint64_t>(ReplayEventType::AUTOPILOT) ? static_cast<std::uint64_t>(AutopilotMode::MONTE_CARLO) + 1 : 0;
+
+		if (type > static_cast<std::uint64_t>(ReplayEventType::RESET) || value > max_value)
+		{
+			printf("%s has a malformed event!\n", path.c_str());
+			return false;
+		}
+
+		step += delta;
+		events.push_back({ step, static_cast<ReplayEventType>(type), static_cast<std::uint8_t>(value) });
+	}
+
+	columns_ = static_cast<int>(columns);
+	rows_ = static_cast<int>(rows);
+	seed_ = seed;
+	step_count_ = step_count;
+	events_ = std::move(events);
+
+	return true;
+}
+
+int Replay::Columns() const
+{
+	return columns_;
+}
+
+int Replay::Rows() const
+{
+	return rows_;
+}
+
+std::uint64_t Replay::Seed() const
+{
+	return seed_;
+}
+
+std::uint64_t Replay::StepCount() const
+{
+	return step_count_;
+}
+
+const std::vector<ReplayEvent>& Replay::Events() const
+{
+	return events_;
+}
\ No newline at end of file
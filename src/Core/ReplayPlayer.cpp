@@ -0,0 +1,75 @@
+#include "Core/ReplayPlayer.hpp"
+#include "Core/Direction.hpp"
+#include "Core/Replay.hpp"
+#include "Core/Simulation.hpp"
+
+#include <cstdint>
+#include <vector>
+
+ReplayPlayer::ReplayPlayer(const Replay& replay) : replay_(replay), next_event_(0), step_(0), autopilot_(false)
+{
+}
+
+bool ReplayPlayer::Done() const
+{
+	return step_ >= replay_.StepCount();
+}
+
+bool ReplayPlayer::ResetPending() const
+{
+	const std::vector<ReplayEvent>& events = replay_.Events();
+
+	for (std::size_t i = next_event_; i < events.size() && events[i].step_ == step_; ++i)
+	{
+		if (events[i].type_ == ReplayEventType::RESET)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+StepResult ReplayPlayer::Advance(Simulation& simulation)
+{
+	const std::vector<ReplayEvent>& events = replay_.Events();
+	Direction direction = simulation.GetSnake().GetDirection();
+
+	while (next_event_ < events.size() && events[next_event_].step_ == step_)
+	{
+		const ReplayEvent& event = events[next_event_++];
+
+		switch (event.type_)
+		{
+			case ReplayEventType::TURN:
+				direction = static_cast<Direction>(event.value_);
+				break;
+			case ReplayEventType::AUTOPILOT:
+				autopilot_ = event.value_ != 0;
+
+				if (autopilot_)
+				{
+					simulation.SetAutopilotMode(static_cast<AutopilotMode>(event.value_ - 1));
+				}
+				break;
+			case ReplayEventType::RESET:
+				simulation.Reset();
+				direction = simulation.GetSnake().GetDirection();
+				break;
+		}
+	}
+
+	++step_;
+
+	return simulation.Step(direction);
+}
+
+bool ReplayPlayer::AutopilotEnabled() const
+{
+	return autopilot_;
+}
+
+std::uint64_t ReplayPlayer::StepIndex() const
+{
+	return step_;
+}
\ No newline at end of file
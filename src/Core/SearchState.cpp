@@ -0,0 +1,43 @@
+#include "Core/SearchState.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+SearchState::SearchState(std::size_t cell_count) : generation_(0)
+{
+	Resize(cell_count);
+}
+
+void SearchState::Resize(std::size_t cell_count)
+{
+	generation_ = 0;
+	seen_.assign(cell_count, 0);
+	closed_.assign(cell_count, 0);
+	parent_.assign(cell_count, -1);
+	local_cost_.assign(cell_count, 0);
+}
+
+std::size_t SearchState::Size() const
+{
+	return parent_.size();
+}
+
+void SearchState::BeginSearch()
+{
+	++generation_;
+
+	// After the counter wraps around old stamps could look current again, so pay for one real clear.
+	if (generation_ == 0)
+	{
+		std::fill(seen_.begin(), seen_.end(), 0);
+		std::fill(closed_.begin(), closed_.end(), 0);
+		generation_ = 1;
+	}
+}
+
+int SearchState::LocalCost(int index) const
+{
+	return Seen(index) ? local_cost_[index] : std::numeric_limits<int>::max();
+}
\ No newline at end of file
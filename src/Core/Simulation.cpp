@@ -0,0 +1,1100 @@
+#include "Core/Simulation.hpp"
+#include "Core/Grid.hpp"
+#include "Core/GridCell.hpp"
+#include "Core/Snake.hpp"
+#include "Utils/BinaryReader.hpp"
+#include "Utils/BinaryWriter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <cassert>
+#include <limits>
+#include <queue>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+	// The default four segments, or as many as fit to the left of the middle column on narrow boards.
+	std::size_t InitialLength(const Grid& grid)
+	{
+		return std::min(4, grid.Columns() / 2 + 1);
+	}
+
+	constexpr char snapshot_magic[4] = { 'S', 'N', 'K', 'S' };
+	constexpr std::uint8_t snapshot_version = 5;
+	constexpr std::size_t snapshot_header_size = 13;
+
+	// Board lengths of steps without food after which the A* autopilot stops waiting for a safe path.
+	constexpr std::uint64_t stalled_board_lengths = 16;
+
+	enum SnapshotFlags : std::uint8_t
+	{
+		GAME_OVER = 1, 
+		WON = 2, 
+		CYCLE_ALIGNED = 4, 
+		CYCLE_BUILT = 8, 
+		CYCLE_REVERSED = 16, 
+		AUTOPILOT_WRAPPED = 32, 
+		PLAN_AHEAD = 64
+	};
+
+	bool Adjacent(const Grid& grid, int from_index, int to_index)
+	{
+		for (int neighbour_index : grid.Neighbours(from_index, true))
+		{
+			if (neighbour_index == to_index)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool ReadCells(BinaryReader& reader, std::size_t cell_count, std::vector<int>& cells)
+	{
+		std::uint64_t count = 0;
+
+		if (!reader.ReadVarint(count) || count > cell_count || count > reader.Remaining())
+		{
+			return false;
+		}
+
+		cells.resize(count);
+
+		for (int& index : cells)
+		{
+			std::uint64_t value = 0;
+
+			if (!reader.ReadVarint(value) || value >= cell_count)
+			{
+				return false;
+			}
+
+			index = static_cast<int>(value);
+		}
+
+		return true;
+	}
+} // namespace
+
+Simulation::Simulation(int columns, int rows, std::uint64_t seed) : 
+	game_over_(false), 
+	won_(false), 
+	tick_ms_(100), 
+	score_(0), 
+	steps_(0), 
+	released_cell_(-1), 
+	grid_(columns, rows), 
+	snake_(InitialLength(grid_), columns, rows), 
+	occupancy_(grid_.CellCount()), 
+	free_cells_(grid_.CellCount()), 
+	path_head_(-1), 
+	path_step_(0), 
+	flood_fill_(columns, rows), 
+	open_cells_(grid_.CellCount()), 
+	reachable_cells_(grid_.CellCount()), 
+	autopilot_mode_(AutopilotMode::A_STAR), 
+	autopilot_wrapped_(false), 
+	cycle_aligned_(false), 
+	cycle_synced_step_(0), 
+	field_synced_step_(0), 
+	food_(-1), 
+	food_step_(0), 
+	rng_(seed), 
+	rollout_active_(false), 
+	rollout_start_()
+{
+	RebuildOccupancy();
+
+	if (!SpawnFood())
+	{
+		game_over_ = true;
+		won_ = true;
+	}
+}
+
+void Simulation::Reset()
+{
+	Reset(Snake(InitialLength(grid_), grid_.Columns(), grid_.Rows()).SnakeGridIndices(), Direction::RIGHT);
+}
+
+void Simulation::Reset(const std::vector<int>& body, Direction direction)
+{
+	score_ = 0;
+	steps_ = 0;
+	released_cell_ = -1;
+	snake_.Reset(body, direction);
+	RebuildOccupancy();
+	shortest_path_cells_.clear();
+	cycle_aligned_ = false;
+	distance_field_.Invalidate();
+	tick_ms_ = 100;
+	game_over_ = false;
+	won_ = false;
+
+	if (!SpawnFood())
+	{
+		game_over_ = true;
+		won_ = true;
+	}
+}
+
+StepResult Simulation::Step(Direction direction)
+{
+	if (game_over_)
+	{
+		return won_ ? StepResult::WON : StepResult::COLLIDED;
+	}
+
+	snake_.SetDirection(direction);
+
+	const int next_index = NextCell(snake_.GetHead(), snake_.GetDirection());
+	const int tail_index = snake_.GetTail();
+	const bool ate_food = next_index == food_;
+
+	// The tail moves out of the way this step unless the snake is growing.
+	if (occupancy_.Test(next_index) && (ate_food || next_index != tail_index))
+	{
+		game_over_ = true;
+		return StepResult::COLLIDED;
+	}
+
+	++steps_;
+	released_cell_ = ate_food ? -1 : tail_index;
+
+	if (!ate_food)
+	{
+		occupancy_.Reset(tail_index);
+		free_cells_.Insert(tail_index);
+	}
+
+	if (rollout_active_)
+	{
+		rollout_moves_.push_back({ next_index, tail_index, snake_.Segment(snake_.Capacity() - 1), ate_food });
+	}
+
+	occupancy_.Set(next_index);
+	free_cells_.Erase(next_index);
+	snake_.Move(next_index, ate_food);
+
+	if (!ate_food)
+	{
+		return StepResult::MOVED;
+	}
+
+	IncrementScore();
+	SpeedUp();
+
+	if (!SpawnFood())
+	{
+		game_over_ = true;
+		won_ = true;
+		return StepResult::WON;
+	}
+
+	return StepResult::ATE_FOOD;
+}
+
+Direction Simulation::AutopilotDirection()
+{
+	switch (autopilot_mode_)
+	{
+		case AutopilotMode::A_STAR:
+		case AutopilotMode::MONTE_CARLO:
+			return AStarDirection();
+
+		case AutopilotMode::HAMILTONIAN:
+			return HamiltonianDirection();
+
+		case AutopilotMode::DISTANCE_FIELD:
+			return DistanceFieldDirection();
+	}
+
+	return snake_.GetDirection();
+}
+
+AutopilotMode Simulation::GetAutopilotMode() const
+{
+	return autopilot_mode_;
+}
+
+void Simulation::SetAutopilotMode(AutopilotMode autopilot_mode)
+{
+	autopilot_mode_ = autopilot_mode;
+	shortest_path_cells_.clear();
+	cycle_aligned_ = false;
+	distance_field_.Invalidate();
+}
+
+bool Simulation::AutopilotWrapped() const
+{
+	return autopilot_wrapped_;
+}
+
+void Simulation::SetAutopilotWrapped(bool wrapped)
+{
+	autopilot_wrapped_ = wrapped;
+	shortest_path_cells_.clear();
+	distance_field_.Invalidate();
+}
+
+const DistanceField& Simulation::GetDistanceField() const
+{
+	return distance_field_;
+}
+
+Direction Simulation::AStarDirection()
+{
+	if (path_head_ != snake_.GetHead() || path_step_ != steps_)
+	{
+		shortest_path_cells_.clear();
+	}
+
+	// A path that leaves the snake boxed in once it has eaten is not taken; chase the tail until a safe one opens.
+	// Near a full board the tail chase can go round the same loop for good, with the food walled in by the body,
+	// and the random tie-breaks in TailChaseDirection only sometimes reshape it. After that has had its chance,
+	// take the first path to the food that opens: the game then ends one way or the other.
+	const bool stalled = steps_ - food_step_ > stalled_board_lengths * grid_.CellCount();
+
+	if (shortest_path_cells_.empty() && (food_ == -1 || !FindAStarPath(snake_.GetHead(), food_, autopilot_wrapped_) 
+		|| (!stalled && !PathKeepsTailReachable())))
+	{
+		shortest_path_cells_.clear();
+
+		return TailChaseDirection();
+	}
+
+	const int next_index = shortest_path_cells_.back();
+	shortest_path_cells_.pop_back();
+	path_head_ = next_index;
+	path_step_ = steps_ + 1;
+
+	return DirectionTowards(snake_.GetHead(), next_index);
+}
+
+bool Simulation::TailReachable(int head_index, int tail_index)
+{
+	open_cells_.Set(tail_index);
+	reachable_cells_.Clear();
+	reachable_cells_.Set(head_index);
+
+	return flood_fill_.Fill(open_cells_, reachable_cells_, true, tail_index);
+}
+
+bool Simulation::PathKeepsTailReachable()
+{
+	const std::size_t path_length = shortest_path_cells_.size();
+	const std::size_t length = snake_.Length();
+
+	if (length + 1 >= grid_.CellCount())
+	{
+		return true;
+	}
+
+	// After the path the body is the path (food first) followed by the front of the old body, one longer than now.
+	// Segments past that have been vacated, and path cells past that have been left again.
+	open_cells_.AssignComplement(occupancy_);
+
+	for (std::size_t i = path_length > length ? 0 : length + 1 - path_length; i < length; ++i)
+	{
+		open_cells_.Set(snake_.Segment(i));
+	}
+
+	for (std::size_t i = 0; i < path_length && i <= length; ++i)
+	{
+		open_cells_.Reset(shortest_path_cells_[i]);
+	}
+
+	const int tail_index = path_length > length ? shortest_path_cells_[length] : snake_.Segment(length - path_length);
+
+	return TailReachable(shortest_path_cells_.front(), tail_index);
+}
+
+bool Simulation::StepKeepsTailReachable(int next_index)
+{
+	const int tail_index = snake_.GetTail();
+	const std::size_t length = snake_.Length();
+	const bool eats = next_index == food_;
+
+	// Take the step: the tail moves on unless the food is eaten.
+	open_cells_.AssignComplement(occupancy_);
+
+	if (!eats)
+	{
+		open_cells_.Set(tail_index);
+	}
+
+	open_cells_.Reset(next_index);
+
+	return TailReachable(next_index, eats ? tail_index : length > 1 ? snake_.Segment(length - 2) : next_index);
+}
+
+Direction Simulation::TailChaseDirection()
+{
+	const int head_index = snake_.GetHead();
+	const int tail_index = snake_.GetTail();
+	const std::size_t length = snake_.Length();
+
+	int best_index = -1;
+	int best_distance = -1;
+	int largest_index = -1;
+	std::size_t largest_area = 0;
+	std::array<int, 4> safe_indices;
+	std::size_t safe_count = 0;
+
+	for (int neighbour_index : grid_.Neighbours(head_index, true))
+	{
+		const bool eats = neighbour_index == food_;
+
+		if (occupancy_.Test(neighbour_index) && (eats || neighbour_index != tail_index))
+		{
+			continue;
+		}
+
+		if (StepKeepsTailReachable(neighbour_index))
+		{
+			safe_indices[safe_count++] = neighbour_index;
+
+			const int new_tail_index = eats ? tail_index : length > 1 ? snake_.Segment(length - 2) : neighbour_index;
+
+			// Of the safe cells, take the one furthest from the tail to make the most room before it catches up.
+			const int distance = grid_.Distance(neighbour_index, new_tail_index, true);
+
+			if (distance > best_distance)
+			{
+				best_index = neighbour_index;
+				best_distance = distance;
+			}
+		}
+		else if (best_index == -1)
+		{
+			// Cut off either way: head for the biggest pocket to last as long as possible.
+			if (reachable_cells_.Count() > largest_area)
+			{
+				largest_index = neighbour_index;
+				largest_area = reachable_cells_.Count();
+			}
+		}
+	}
+
+	if (best_index == -1)
+	{
+		best_index = largest_index;
+	}
+	else if (steps_ - food_step_ > grid_.CellCount())
+	{
+		// A whole board's worth of steps without food means the furthest-from-tail rule is going round the
+		// same loop. Break the tie pseudo-randomly from the game state instead, so that the free cells drift
+		// and the food can open up; rng_ is left alone because replays rely on it for the food only.
+		best_index = safe_indices[SplitMix64(steps_ ^ (static_cast<std::uint64_t>(head_index) << 32)) % safe_count];
+	}
+
+	return best_index != -1 ? DirectionTowards(head_index, best_index) : snake_.GetDirection();
+}
+
+Direction Simulation::HamiltonianDirection()
+{
+	const int head_index = snake_.GetHead();
+	const int tail_index = snake_.GetTail();
+
+	if (cycle_.Empty())
+	{
+		if (!cycle_.Build(grid_.Columns(), grid_.Rows()))
+		{
+			return AStarDirection();
+		}
+
+		// Run the tour the way the snake is already facing.
+		if (snake_.Length() > 1 && cycle_.Successor(head_index) == snake_.Segment(1))
+		{
+			cycle_.Reverse();
+		}
+	}
+
+	// Shortcuts are only safe while the body lies on the cycle in order, which holds as long as every step
+	// since the last check was taken here. Anything else (a reset, the player steering) needs a fresh check.
+	if (!cycle_aligned_ || cycle_synced_step_ != steps_)
+	{
+		cycle_aligned_ = SnakeFollowsCycle();
+	}
+
+	cycle_synced_step_ = steps_ + 1;
+
+	// An A* plan from an earlier fallback no longer starts at the head once a cycle step has been taken.
+	shortest_path_cells_.clear();
+
+	const int successor_index = cycle_.Successor(head_index);
+
+	if (!cycle_aligned_)
+	{
+		if ((!occupancy_.Test(successor_index) || successor_index == tail_index) && StepKeepsTailReachable(successor_index))
+		{
+			return DirectionTowards(head_index, successor_index);
+		}
+
+		return AStarDirection();
+	}
+
+	// The free cells are exactly the ones strictly between the head and the tail along the cycle, so any of
+	// them can be jumped to without cutting the tail off. Never jump past the food.
+	const int tail_distance = cycle_.Distance(head_index, tail_index);
+	const int food_distance = food_ != -1 ? cycle_.Distance(head_index, food_) : tail_distance;
+
+	int best_index = successor_index;
+	int best_distance = 1;
+
+	for (int neighbour_index : grid_.Neighbours(head_index, true))
+	{
+		if (occupancy_.Test(neighbour_index))
+		{
+			continue;
+		}
+
+		const int distance = cycle_.Distance(head_index, neighbour_index);
+
+		if (distance > best_distance && distance < tail_distance && distance <= food_distance)
+		{
+			best_index = neighbour_index;
+			best_distance = distance;
+		}
+	}
+
+	return DirectionTowards(head_index, best_index);
+}
+
+Direction Simulation::DistanceFieldDirection()
+{
+	const int head_index = snake_.GetHead();
+
+	if (food_ == -1)
+	{
+		return snake_.GetDirection();
+	}
+
+	// While the snake keeps descending the field, every cell it has entered since the search lies further
+	// from the food than the head does, so the distances ahead of it stay exact and only the cells the tail
+	// frees need patching. Any other history (new food, the player steering, a reset) needs a fresh search.
+	if (distance_field_.Empty() || distance_field_.Source() != food_ || distance_field_.Wrapped() != autopilot_wrapped_ 
+		|| (field_synced_step_ != steps_ && field_synced_step_ + 1 != steps_))
+	{
+		distance_field_.Compute(grid_, occupancy_, food_, autopilot_wrapped_);
+	}
+	else if (field_synced_step_ + 1 == steps_ && released_cell_ != -1)
+	{
+		distance_field_.Release(grid_, occupancy_, released_cell_);
+	}
+
+	field_synced_step_ = steps_;
+
+	int best_index = -1;
+	int best_distance = DistanceField::unreachable;
+
+	for (int neighbour_index : grid_.Neighbours(head_index, autopilot_wrapped_))
+	{
+		if (!occupancy_.Test(neighbour_index) && distance_field_.Distance(neighbour_index) < best_distance)
+		{
+			best_index = neighbour_index;
+			best_distance = distance_field_.Distance(neighbour_index);
+		}
+	}
+
+	if (best_index != -1)
+	{
+		return DirectionTowards(head_index, best_index);
+	}
+
+	// The food is out of reach for now: stay alive on any free cell until the tail opens a way.
+	for (int neighbour_index : grid_.Neighbours(head_index, true))
+	{
+		if (!occupancy_.Test(neighbour_index))
+		{
+			return DirectionTowards(head_index, neighbour_index);
+		}
+	}
+
+	return snake_.GetDirection();
+}
+
+bool Simulation::SnakeFollowsCycle() const
+{
+	const int tail_index = snake_.GetTail();
+	int previous_distance = 0;
+
+	for (std::size_t i = snake_.Length() - 1; i-- > 0;)
+	{
+		const int distance = cycle_.Distance(tail_index, snake_.Segment(i));
+
+		if (distance <= previous_distance)
+		{
+			return false;
+		}
+
+		previous_distance = distance;
+	}
+
+	return true;
+}
+
+bool Simulation::SpawnFood()
+{
+	if (free_cells_.Empty())
+	{
+		food_ = -1;
+		return false;
+	}
+
+	// A few random cells first, which almost always finds a free one in O(1) unless the board is nearly full;
+	// then a uniform draw over the free cells, in O(log n). Either way the food only depends on the RNG and which cells are free, not on how the set came about.
+	std::uniform_int_distribution<int> random_cell(0, static_cast<int>(grid_.CellCount()) - 1);
+	food_ = -1;
+
+	for (int attempt = 0; attempt < 4 && food_ == -1; ++attempt)
+	{
+		const int index = random_cell(rng_);
+		food_ = free_cells_.Contains(index) ? index : -1;
+	}
+
+	if (food_ == -1)
+	{
+		std::uniform_int_distribution<std::size_t> random_position(0, free_cells_.Size() - 1);
+		food_ = free_cells_.At(random_position(rng_));
+	}
+
+	food_step_ = steps_;
+
+	return true;
+}
+
+int Simulation::Food() const
+{
+	return food_;
+}
+
+const Grid& Simulation::GetGrid() const
+{
+	return grid_;
+}
+
+const Snake& Simulation::GetSnake() const
+{
+	return snake_;
+}
+
+const Bitboard& Simulation::Occupancy() const
+{
+	return occupancy_;
+}
+
+bool Simulation::IsOccupied(int index) const
+{
+	return occupancy_.Test(index);
+}
+
+const std::vector<int>& Simulation::ShortestPathCells() const
+{
+	return shortest_path_cells_;
+}
+
+void Simulation::ClearShortestPath()
+{
+	shortest_path_cells_.clear();
+}
+
+bool Simulation::GameOver() const
+{
+	return game_over_;
+}
+
+bool Simulation::Won() const
+{
+	return won_;
+}
+
+const FreeCellSet& Simulation::FreeCells() const
+{
+	return free_cells_;
+}
+
+int Simulation::Score() const
+{
+	return score_;
+}
+
+int Simulation::TickMs() const
+{
+	return tick_ms_;
+}
+
+std::uint64_t Simulation::Steps() const
+{
+	return steps_;
+}
+
+int Simulation::ReleasedCell() const
+{
+	return released_cell_;
+}
+
+void Simulation::IncrementScore()
+{
+	score_ += 10;
+}
+
+void Simulation::RebuildOccupancy()
+{
+	occupancy_.Clear();
+	free_cells_.Fill(grid_.CellCount());
+
+	snake_.ForEachSegment([this](int index)
+	{
+		occupancy_.Set(index);
+		free_cells_.Erase(index);
+	});
+}
+
+void Simulation::SpeedUp()
+{
+	int minimum_speed = 50;
+
+	if (tick_ms_ > minimum_speed)
+	{
+		--tick_ms_;
+	}
+}
+
+int Simulation::NextCell(int index, Direction direction) const
+{
+	return grid_.Neighbour(index, direction, true);
+}
+
+Direction Simulation::DirectionTowards(int from_index, int to_index) const
+{
+	for (Direction direction : { Direction::LEFT, Direction::RIGHT, Direction::UP, Direction::DOWN })
+	{
+		if (grid_.Neighbour(from_index, direction, true) == to_index)
+		{
+			return direction;
+		}
+	}
+
+	assert(false && "cells are not adjacent");
+	return snake_.GetDirection();
+}
+
+bool Simulation::FindAStarPath(int start_index, int target_index, bool wrapped)
+{
+	// Ordered by estimated total cost, then by remaining estimate so that ties go deeper instead of
+	// flooding the whole band of equally good cells on an open board.
+	using OpenEntry = std::tuple<int, int, int>;
+	std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<OpenEntry>> min_heap;
+
+	auto heuristic = [this, target_index, wrapped](int index) { return grid_.Distance(index, target_index, wrapped); };
+
+	// Sized on first use so that boards which never search do not pay for the arrays.
+	if (search_state_.Size() != grid_.CellCount())
+	{
+		search_state_.Resize(grid_.CellCount());
+	}
+
+	search_state_.BeginSearch();
+	search_state_.Relax(start_index, -1, 0);
+	min_heap.push({ heuristic(start_index), heuristic(start_index), start_index });
+
+	while (!min_heap.empty())
+	{
+		const int current_index = std::get<2>(min_heap.top());
+		min_heap.pop();
+
+		if (search_state_.Closed(current_index))
+		{
+			continue;
+		}
+
+		if (current_index == target_index)
+		{
+			break;
+		}
+
+		search_state_.Close(current_index);
+
+		const int lower_cost = search_state_.LocalCost(current_index) + 1;
+
+		for (int neighbour_index : grid_.Neighbours(current_index, wrapped))
+		{
+			if (occupancy_.Test(neighbour_index) || search_state_.Closed(neighbour_index))
+			{
+				continue;
+			}
+
+			if (lower_cost < search_state_.LocalCost(neighbour_index))
+			{
+				search_state_.Relax(neighbour_index, current_index, lower_cost);
+				const int remaining_cost = heuristic(neighbour_index);
+				min_heap.push({ lower_cost + remaining_cost, remaining_cost, neighbour_index });
+			}
+		}
+	}
+	
+	shortest_path_cells_.clear();
+
+	if (!search_state_.Seen(target_index))
+	{
+		return false;
+	}
+
+	for (int index = target_index; index != start_index; index = search_state_.Parent(index))
+	{
+		shortest_path_cells_.push_back(index);
+	}
+
+	return true;
+}
+
+void Simulation::CopyGameState(const Simulation& other)
+{
+	assert(grid_.CellCount() == other.grid_.CellCount());
+
+	game_over_ = other.game_over_;
+	won_ = other.won_;
+	tick_ms_ = other.tick_ms_;
+	score_ = other.score_;
+	steps_ = other.steps_;
+	released_cell_ = other.released_cell_;
+	snake_ = other.snake_;
+	occupancy_ = other.occupancy_;
+	free_cells_ = other.free_cells_;
+	food_ = other.food_;
+	food_step_ = other.food_step_;
+	rng_ = other.rng_;
+
+	shortest_path_cells_.clear();
+	cycle_aligned_ = false;
+	distance_field_.Invalidate();
+}
+
+void Simulation::BeginRollout()
+{
+	rollout_active_ = true;
+	rollout_start_ = { game_over_, won_, tick_ms_, score_, steps_, released_cell_, food_, food_step_, snake_.GetDirection(), snake_.Capacity() };
+	rollout_moves_.clear();
+}
+
+bool Simulation::EndRollout()
+{
+	rollout_active_ = false;
+
+	if (snake_.Capacity() != rollout_start_.snake_capacity_)
+	{
+		rollout_moves_.clear();
+		return false;
+	}
+
+	// Latest first, undoing Step's changes in the reverse of the order it made them.
+	for (auto move = rollout_moves_.rbegin(); move != rollout_moves_.rend(); ++move)
+	{
+		snake_.Unmove(move->overwritten_, move->ate_food_);
+		free_cells_.Insert(move->next_index_);
+		occupancy_.Reset(move->next_index_);
+
+		if (!move->ate_food_)
+		{
+			free_cells_.Erase(move->tail_index_);
+			occupancy_.Set(move->tail_index_);
+		}
+	}
+
+	rollout_moves_.clear();
+
+	game_over_ = rollout_start_.game_over_;
+	won_ = rollout_start_.won_;
+	tick_ms_ = rollout_start_.tick_ms_;
+	score_ = rollout_start_.score_;
+	steps_ = rollout_start_.steps_;
+	released_cell_ = rollout_start_.released_cell_;
+	food_ = rollout_start_.food_;
+	food_step_ = rollout_start_.food_step_;
+	snake_.RestoreDirection(rollout_start_.direction_);
+
+	return true;
+}
+
+void Simulation::Reseed(std::uint64_t seed)
+{
+	rng_.Seed(seed);
+}
+
+std::uint64_t Simulation::PeekRandom() const
+{
+	Xoshiro256 rng = rng_;
+
+	return rng();
+}
+
+void Simulation::Snapshot(std::vector<std::uint8_t>& bytes) const
+{
+	BinaryWriter writer(bytes);
+
+	writer.WriteBytes(snapshot_magic, sizeof(snapshot_magic));
+	writer.WriteUint(snapshot_version, 1);
+	writer.WriteUint(static_cast<std::uint32_t>(grid_.Columns()), 4);
+	writer.WriteUint(static_cast<std::uint32_t>(grid_.Rows()), 4);
+
+	std::uint8_t flags = 0;
+	flags |= game_over_ ? GAME_OVER : 0;
+	flags |= won_ ? WON : 0;
+	flags |= cycle_aligned_ ? CYCLE_ALIGNED : 0;
+	flags |= autopilot_wrapped_ ? AUTOPILOT_WRAPPED : 0;
+	flags |= !cycle_.Empty() ? CYCLE_BUILT : 0;
+	flags |= cycle_.Reversed() ? CYCLE_REVERSED : 0;
+
+	// Between an autopilot decision and its step the plan already starts one cell ahead of the head.
+	const bool plan_current = path_head_ == snake_.GetHead() && path_step_ == steps_;
+	const bool plan_ahead = !plan_current && path_step_ == steps_ + 1 && Adjacent(grid_, snake_.GetHead(), path_head_);
+	flags |= plan_ahead ? PLAN_AHEAD : 0;
+
+	writer.WriteUint(flags, 1);
+	writer.WriteUint(static_cast<std::uint8_t>(autopilot_mode_), 1);
+	writer.WriteUint(static_cast<std::uint8_t>(snake_.GetDirection()), 1);
+	writer.WriteVarint(static_cast<std::uint64_t>(tick_ms_));
+	writer.WriteVarint(static_cast<std::uint64_t>(score_));
+	writer.WriteVarint(steps_);
+	writer.WriteVarint(cycle_synced_step_);
+	writer.WriteVarint(static_cast<std::uint64_t>(released_cell_ + 1));
+	writer.WriteVarint(static_cast<std::uint64_t>(food_ + 1));
+	writer.WriteVarint(food_step_);
+
+	// The body as its head followed by two bits per segment for the way to the next one.
+	writer.WriteVarint(snake_.Length());
+	writer.WriteVarint(static_cast<std::uint64_t>(snake_.GetHead()));
+
+	std::uint8_t packed = 0;
+
+	for (std::size_t i = 1; i < snake_.Length(); ++i)
+	{
+		packed |= static_cast<std::uint8_t>(DirectionTowards(snake_.Segment(i - 1), snake_.Segment(i))) << (2 * ((i - 1) % 4));
+
+		if ((i - 1) % 4 == 3 || i + 1 == snake_.Length())
+		{
+			writer.WriteUint(packed, 1);
+			packed = 0;
+		}
+	}
+
+	// The plan as the cells from the food back to the next move; one the snake was steered off is dropped.
+	if (plan_current || plan_ahead)
+	{
+		writer.WriteVarint(shortest_path_cells_.size() + (plan_ahead ? 1 : 0));
+
+		for (int index : shortest_path_cells_)
+		{
+			writer.WriteVarint(static_cast<std::uint64_t>(index));
+		}
+
+		if (plan_ahead)
+		{
+			writer.WriteVarint(static_cast<std::uint64_t>(path_head_));
+		}
+	}
+	else
+	{
+		writer.WriteVarint(0);
+	}
+
+	// The free cells are not stored: they are the cells off the body, and the food only depends on which they are.
+	for (std::uint64_t word : rng_.State())
+	{
+		writer.WriteUint(word, 8);
+	}
+}
+
+bool Simulation::SnapshotBoardSize(const std::uint8_t* data, std::size_t size, int& columns, int& rows)
+{
+	BinaryReader reader(data, size);
+	char magic[4] = {};
+	std::uint64_t version = 0;
+	std::uint64_t snapshot_columns = 0;
+	std::uint64_t snapshot_rows = 0;
+
+	if (!reader.ReadBytes(magic, sizeof(magic)) || !std::equal(magic, magic + 4, snapshot_magic) || !reader.ReadUint(version, 1) 
+		|| version != snapshot_version || !reader.ReadUint(snapshot_columns, 4) || !reader.ReadUint(snapshot_rows, 4))
+	{
+		return false;
+	}
+
+	columns = static_cast<int>(snapshot_columns);
+	rows = static_cast<int>(snapshot_rows);
+
+	return true;
+}
+
+bool Simulation::Restore(const std::uint8_t* data, std::size_t size)
+{
+	int columns = 0;
+	int rows = 0;
+
+	if (!SnapshotBoardSize(data, size, columns, rows) || columns != grid_.Columns() || rows != grid_.Rows())
+	{
+		return false;
+	}
+
+	const std::size_t cell_count = grid_.CellCount();
+	BinaryReader reader(data + snapshot_header_size, size - snapshot_header_size);
+
+	std::uint64_t flags = 0;
+	std::uint64_t autopilot_mode = 0;
+	std::uint64_t direction = 0;
+	std::uint64_t tick_ms = 0;
+	std::uint64_t score = 0;
+	std::uint64_t steps = 0;
+	std::uint64_t cycle_synced_step = 0;
+	std::uint64_t released_cell = 0;
+	std::uint64_t food = 0;
+	std::uint64_t food_step = 0;
+	std::uint64_t length = 0;
+	std::uint64_t head = 0;
+
+	if (!reader.ReadUint(flags, 1) || !reader.ReadUint(autopilot_mode, 1) || autopilot_mode > static_cast<std::uint64_t>(AutopilotMode::MONTE_CARLO) 
+		|| !reader.ReadUint(direction, 1) || direction > 3 || !reader.ReadVarint(tick_ms) 
+		|| !reader.ReadVarint(score) || !reader.ReadVarint(steps) || !reader.ReadVarint(cycle_synced_step) 
+		|| !reader.ReadVarint(released_cell) || released_cell > cell_count || !reader.ReadVarint(food) || food > cell_count 
+		|| !reader.ReadVarint(food_step) || food_step > steps 
+		|| !reader.ReadVarint(length) || length < 1 || length > cell_count || !reader.ReadVarint(head) || head >= cell_count)
+	{
+		return false;
+	}
+
+	std::vector<int> body(length);
+	Bitboard occupancy(cell_count);
+
+	body[0] = static_cast<int>(head);
+	occupancy.Set(body[0]);
+
+	std::uint64_t packed = 0;
+
+	for (std::size_t i = 1; i < body.size(); ++i)
+	{
+		if ((i - 1) % 4 == 0 && !reader.ReadUint(packed, 1))
+		{
+			return false;
+		}
+
+		body[i] = NextCell(body[i - 1], static_cast<Direction>((packed >> (2 * ((i - 1) % 4))) & 3));
+
+		if (occupancy.Test(body[i]))
+		{
+			return false;
+		}
+
+		occupancy.Set(body[i]);
+	}
+
+	// The food sits on a free cell, and only a full board has none.
+	if (food == 0 ? length != cell_count : occupancy.Test(static_cast<int>(food) - 1))
+	{
+		return false;
+	}
+
+	std::vector<int> path;
+	std::array<std::uint64_t, 4> rng_state = {};
+
+	if (!ReadCells(reader, cell_count, path))
+	{
+		return false;
+	}
+
+	// A saved plan leads from a neighbour of the head to the food over free cells, one step at a time.
+	if (path.empty() ? (flags & PLAN_AHEAD) != 0 : !Adjacent(grid_, body[0], path.back()) || path.front() != static_cast<int>(food) - 1)
+	{
+		return false;
+	}
+
+	for (std::size_t i = 0; i < path.size(); ++i)
+	{
+		if (occupancy.Test(path[i]) || (i > 0 && !Adjacent(grid_, path[i - 1], path[i])))
+		{
+			return false;
+		}
+	}
+
+	for (std::uint64_t& word : rng_state)
+	{
+		if (!reader.ReadUint(word, 8))
+		{
+			return false;
+		}
+	}
+
+	Xoshiro256 rng;
+
+	if (!rng.SetState(rng_state))
+	{
+		return false;
+	}
+
+	game_over_ = (flags & GAME_OVER) != 0;
+	won_ = (flags & WON) != 0;
+	tick_ms_ = static_cast<int>(tick_ms);
+	score_ = static_cast<int>(score);
+	steps_ = steps;
+	released_cell_ = static_cast<int>(released_cell) - 1;
+	food_ = static_cast<int>(food) - 1;
+	food_step_ = food_step;
+	snake_ = Snake(body, static_cast<Direction>(direction), grid_.Columns(), grid_.Rows());
+	RebuildOccupancy();
+	shortest_path_cells_ = path;
+	path_head_ = snake_.GetHead();
+	path_step_ = steps_;
+
+	if ((flags & PLAN_AHEAD) != 0)
+	{
+		path_head_ = shortest_path_cells_.back();
+		path_step_ = steps_ + 1;
+		shortest_path_cells_.pop_back();
+	}
+	rng_ = rng;
+
+	autopilot_mode_ = static_cast<AutopilotMode>(autopilot_mode);
+	autopilot_wrapped_ = (flags & AUTOPILOT_WRAPPED) != 0;
+	distance_field_.Invalidate();
+	cycle_aligned_ = (flags & CYCLE_ALIGNED) != 0;
+	cycle_synced_step_ = cycle_synced_step;
+
+	const bool cycle_built = (flags & CYCLE_BUILT) != 0;
+	const bool cycle_reversed = (flags & CYCLE_REVERSED) != 0;
+
+	if (!cycle_built)
+	{
+		cycle_ = HamiltonianCycle();
+	}
+	else if (cycle_.Empty() || cycle_.Reversed() != cycle_reversed)
+	{
+		cycle_.Build(grid_.Columns(), grid_.Rows());
+
+		if (cycle_reversed)
+		{
+			cycle_.Reverse();
+		}
+	}
+
+	return true;
+}
+
+bool Simulation::SaveSnapshot(const std::string& path) const
+{
+	std::vector<std::uint8_t> bytes;
+	Snapshot(bytes);
+
+	return BinaryWriter::WriteFile(path, bytes);
+}
+
+bool Simulation::LoadSnapshot(const std::string& path)
+{
+	std::vector<std::uint8_t> bytes;
+
+	return BinaryReader::ReadFile(path, bytes) && Restore(bytes.data(), bytes.size());
+}
\ No newline at end of file
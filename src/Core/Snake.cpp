@@ -0,0 +1,164 @@
+#include "Core/Snake.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+Snake::Snake(std::size_t segments_size, int columns, int rows) : 
+	direction_(Direction::RIGHT), 
+	head_(0), 
+	length_(segments_size), 
+	max_length_(static_cast<std::size_t>(columns) * rows)
+{
+	const int x_half = columns / 2;
+	const int y_half = rows / 2;
+
+	assert(segments_size > 0 && static_cast<int>(segments_size) <= x_half + 1);
+
+	segments_.resize(std::min<std::size_t>(std::max<std::size_t>(segments_size, 64), max_length_));
+
+	for (std::size_t i = 0; i < length_; ++i)
+	{
+		segments_[i] = y_half * columns + x_half - static_cast<int>(i);
+	}
+}
+
+Snake::Snake(const std::vector<int>& segments, Direction direction, int columns, int rows) : 
+	direction_(direction), 
+	head_(0), 
+	length_(segments.size()), 
+	max_length_(static_cast<std::size_t>(columns) * rows)
+{
+	assert(!segments.empty() && segments.size() <= max_length_);
+
+	segments_ = segments;
+	segments_.resize(std::min<std::size_t>(std::max<std::size_t>(segments.size() * 2, 64), max_length_));
+}
+
+void Snake::Reset(const std::vector<int>& segments, Direction direction)
+{
+	assert(!segments.empty() && segments.size() <= max_length_);
+
+	if (segments_.size() < segments.size())
+	{
+		segments_.resize(std::min<std::size_t>(std::max<std::size_t>(segments.size() * 2, 64), max_length_));
+	}
+
+	std::copy(segments.begin(), segments.end(), segments_.begin());
+	direction_ = direction;
+	head_ = 0;
+	length_ = segments.size();
+}
+
+std::size_t Snake::Length() const
+{
+	return length_;
+}
+
+std::size_t Snake::Capacity() const
+{
+	return segments_.size();
+}
+
+int Snake::GetHead() const
+{
+	return segments_[head_];
+}
+
+int Snake::GetTail() const
+{
+	return Segment(length_ - 1);
+}
+
+Direction Snake::GetDirection() const
+{
+	return direction_;
+}
+
+void Snake::SetDirection(Direction direction)
+{
+	switch (direction)
+	{
+		case Direction::LEFT:
+			if (direction_ != Direction::RIGHT)
+			{
+				direction_ = Direction::LEFT;
+			}
+			break;
+		case Direction::RIGHT:
+			if (direction_ != Direction::LEFT)
+			{
+				direction_ = Direction::RIGHT;
+			}
+			break;
+		case Direction::UP:
+			if (direction_ != Direction::DOWN)
+			{
+				direction_ = Direction::UP;
+			}
+			break;
+		case Direction::DOWN:
+			if (direction_ != Direction::UP)
+			{
+				direction_ = Direction::DOWN;
+			}
+			break;
+	}
+}
+
+void Snake::Move(int next_index, bool grow)
+{
+	assert(!grow || length_ < max_length_);
+
+	if (grow && length_ == segments_.size())
+	{
+		Grow(std::min(segments_.size() * 2, max_length_));
+	}
+
+	head_ = head_ == 0 ? segments_.size() - 1 : head_ - 1;
+	segments_[head_] = next_index;
+
+	if (grow)
+	{
+		++length_;
+	}
+}
+
+void Snake::Unmove(int overwritten, bool grew)
+{
+	segments_[head_] = overwritten;
+	head_ = head_ + 1 == segments_.size() ? 0 : head_ + 1;
+
+	if (grew)
+	{
+		--length_;
+	}
+}
+
+void Snake::RestoreDirection(Direction direction)
+{
+	direction_ = direction;
+}
+
+void Snake::Grow(std::size_t capacity)
+{
+	std::vector<int> segments;
+	segments.reserve(capacity);
+
+	ForEachSegment([&segments](int index) { segments.push_back(index); });
+	segments.resize(capacity);
+
+	segments_.swap(segments);
+	head_ = 0;
+}
+
+std::vector<int> Snake::SnakeGridIndices() const
+{
+	std::vector<int> snake_grid_indices;
+	snake_grid_indices.reserve(length_);
+
+	ForEachSegment([&snake_grid_indices](int index) { snake_grid_indices.emplace_back(index); });
+
+	return snake_grid_indices;
+}
\ No newline at end of file
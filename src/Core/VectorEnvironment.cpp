@@ -0,0 +1,180 @@
+#include "Core/VectorEnvironment.hpp"
+#include "Core/Direction.hpp"
+#include "Core/Simulation.hpp"
+#include "Utils/WorkStealingPool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace
+{
+	// Games per pool task; stepping one game is far too little work to hand out on its own.
+	constexpr std::size_t games_per_chunk = 16;
+} // namespace
+
+VectorEnvironment::VectorEnvironment(std::size_t game_count, int columns, int rows, std::uint64_t seed, std::uint64_t max_episode_steps, 
+	std::size_t thread_count) : 
+	start_direction_(Direction::RIGHT), 
+	episode_steps_(game_count, 0), 
+	observed_head_(game_count, -1), 
+	observed_food_(game_count, -1), 
+	observations_(nullptr), 
+	pool_(std::make_unique<WorkStealingPool>(thread_count)), 
+	chunk_size_(games_per_chunk), 
+	max_episode_steps_(max_episode_steps)
+{
+	for (std::size_t i = 0; i < game_count; ++i)
+	{
+		games_.emplace_back(std::make_unique<Simulation>(columns, rows, seed + i));
+	}
+
+	if (!games_.empty())
+	{
+		start_body_ = games_.front()->GetSnake().SnakeGridIndices();
+		start_direction_ = games_.front()->GetSnake().GetDirection();
+	}
+}
+
+VectorEnvironment::~VectorEnvironment() = default;
+
+template <typename Work>
+void VectorEnvironment::ForEachGame(Work work)
+{
+	// Two pointers of capture fit in std::function's inline storage, so handing out a step allocates nothing.
+	pool_->Run((games_.size() + chunk_size_ - 1) / chunk_size_, [this, &work](std::size_t chunk, std::size_t)
+	{
+		const std::size_t last = std::min(games_.size(), (chunk + 1) * chunk_size_);
+
+		for (std::size_t game = chunk * chunk_size_; game < last; ++game)
+		{
+			work(game);
+		}
+	});
+}
+
+std::size_t VectorEnvironment::GameCount() const
+{
+	return games_.size();
+}
+
+std::size_t VectorEnvironment::ObservationSize() const
+{
+	return games_.empty() ? 0 : plane_count * games_.front()->GetGrid().CellCount();
+}
+
+void VectorEnvironment::Reset(std::uint8_t* observations)
+{
+	ForEachGame([this, observations](std::size_t game)
+	{
+		games_[game]->Reset(start_body_, start_direction_);
+		episode_steps_[game] = 0;
+		WriteObservation(game, observations);
+	});
+
+	observations_ = observations;
+}
+
+void VectorEnvironment::Step(const std::uint8_t* actions, std::uint8_t* observations, float* rewards, std::uint8_t* dones)
+{
+	ForEachGame([this, actions, observations, rewards, dones](std::size_t game)
+	{
+		Simulation& simulation = *games_[game];
+		const StepResult result = simulation.Step(static_cast<Direction>(actions[game] & 3));
+		++episode_steps_[game];
+
+		rewards[game] = result == StepResult::ATE_FOOD ? food_reward : result == StepResult::COLLIDED ? collision_reward 
+			: result == StepResult::WON ? win_reward : 0.0f;
+
+		const bool done = simulation.GameOver() || (max_episode_steps_ != 0 && episode_steps_[game] >= max_episode_steps_);
+		dones[game] = done ? 1 : 0;
+
+		if (done)
+		{
+			simulation.Reset(start_body_, start_direction_);
+			episode_steps_[game] = 0;
+			WriteObservation(game, observations);
+		}
+		else if (observations != observations_)
+		{
+			WriteObservation(game, observations);
+		}
+		else
+		{
+			UpdateObservation(game, observations);
+		}
+	});
+
+	observations_ = observations;
+}
+
+const Simulation& VectorEnvironment::GetSimulation(std::size_t game) const
+{
+	return *games_[game];
+}
+
+void VectorEnvironment::WriteObservation(std::size_t game, std::uint8_t* observations)
+{
+	const Simulation& simulation = *games_[game];
+	const std::size_t cell_count = simulation.GetGrid().CellCount();
+	std::uint8_t* body = observations + game * plane_count * cell_count;
+	std::uint8_t* head = body + cell_count;
+	std::uint8_t* food = head + cell_count;
+
+	std::memset(body, 0, plane_count * cell_count);
+
+	simulation.GetSnake().ForEachSegment([body](int index) { body[index] = 1; });
+
+	body[simulation.GetSnake().GetHead()] = 0;
+	head[simulation.GetSnake().GetHead()] = 1;
+
+	if (simulation.Food() != -1)
+	{
+		food[simulation.Food()] = 1;
+	}
+
+	observed_head_[game] = simulation.GetSnake().GetHead();
+	observed_food_[game] = simulation.Food();
+}
+
+void VectorEnvironment::UpdateObservation(std::size_t game, std::uint8_t* observations)
+{
+	const Simulation& simulation = *games_[game];
+	const std::size_t cell_count = simulation.GetGrid().CellCount();
+	std::uint8_t* body = observations + game * plane_count * cell_count;
+	std::uint8_t* head = body + cell_count;
+	std::uint8_t* food = head + cell_count;
+	const int head_index = simulation.GetSnake().GetHead();
+
+	// The old head joins the body and the tail leaves it, before the new head is placed, which may be on
+	// the cell the tail just left.
+	head[observed_head_[game]] = 0;
+	body[observed_head_[game]] = 1;
+
+	if (simulation.ReleasedCell() != -1)
+	{
+		body[simulation.ReleasedCell()] = 0;
+	}
+
+	body[head_index] = 0;
+	head[head_index] = 1;
+
+	if (observed_food_[game] != simulation.Food())
+	{
+		if (observed_food_[game] != -1)
+		{
+			food[observed_food_[game]] = 0;
+		}
+
+		if (simulation.Food() != -1)
+		{
+			food[simulation.Food()] = 1;
+		}
+	}
+
+	observed_head_[game] = head_index;
+	observed_food_[game] = simulation.Food();
+}
\ No newline at end of file
@@ -1,23 +1,81 @@
 #include "Game.hpp"
-#include "GridCell.hpp"
-#include "Snake.hpp"
+#include "BoardRenderer.hpp"
+#include "GlyphAtlas.hpp"
+#include "Core/Grid.hpp"
+#include "Core/IncrementalPlanner.hpp"
+#include "Core/MonteCarloPlanner.hpp"
+#include "Core/Replay.hpp"
+#include "Core/ReplayPlayer.hpp"
+#include "Core/Simulation.hpp"
+#include "Core/Snake.hpp"
 #include "Utils/Constants.hpp"
+#include "Utils/Metrics.hpp"
 #include "Texture.hpp"
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cmath>
+#include <cstring>
 #include <iostream>
+#include <mutex>
 #include <memory>
-#include <random>
 #include <vector>
-#include <queue>
 #include <sstream>
+#include <string>
+#include <thread>
 
-Game::Game() : 
+namespace
+{
+	std::uint64_t ElapsedNs(std::uint64_t start_counter)
+	{
+		const double seconds = static_cast<double>(SDL_GetPerformanceCounter() - start_counter) / static_cast<double>(SDL_GetPerformanceFrequency());
+
+		return static_cast<std::uint64_t>(seconds * 1e9);
+	}
+
+	bool KeyDirection(SDL_Keycode key, Direction& direction)
+	{
+		switch (key)
+		{
+			case SDLK_LEFT:
+				direction = Direction::LEFT;
+				return true;
+			case SDLK_RIGHT:
+				direction = Direction::RIGHT;
+				return true;
+			case SDLK_UP:
+				direction = Direction::UP;
+				return true;
+			case SDLK_DOWN:
+				direction = Direction::DOWN;
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	bool Opposite(Direction a, Direction b)
+	{
+		switch (a)
+		{
+			case Direction::LEFT:
+				return b == Direction::RIGHT;
+			case Direction::RIGHT:
+				return b == Direction::LEFT;
+			case Direction::UP:
+				return b == Direction::DOWN;
+			default:
+				return b == Direction::UP;
+		}
+	}
+} // namespace
+
+Game::Game(int columns, int rows, std::uint64_t seed) : 
 	title_(constants::game_title), 
 	screen_width_(constants::screen_width), 
 	screen_height_(constants::screen_height), 
@@ -28,55 +86,44 @@ Game::Game() :
 	shortest_path_toggle_(false), 
 	wrapped_shortest_path_toggle_(false), 
 	info_toggle_(false), 
-	last_ms_(0), 
-	tick_ms_(100), 
-	score_(0), 
-	grid_cell_side_(50), 
-	score_info_(std::make_unique<Texture>()), 
+	metrics_toggle_(false), 
+	needs_render_(true), 
+	playback_speed_(1.0), 
+	vsync_(false), 
+	frame_rate_(60), 
+	next_step_(0), 
+	frame_serial_(0), 
+	clear_serial_(0), 
+	board_resync_(true), 
+	published_steps_(0), 
+	published_head_(-1), 
+	published_food_(-1), 
+	path_marks_(static_cast<std::size_t>(columns) * rows, 0), 
+	drawn_serial_(0), 
+	grid_cell_side_(std::max(1, std::min(constants::screen_width / columns, constants::screen_height / rows))), 
+	board_x_((constants::screen_width - grid_cell_side_ * columns) / 2), 
+	board_y_((constants::screen_height - grid_cell_side_ * rows) / 2), 
 	controls_info_(std::make_unique<Texture>()), 
 	toggle_info_(std::make_unique<Texture>()), 
-	toggled_controls_info_(std::make_unique<Texture>()), 
 	game_over_info_(std::make_unique<Texture>()), 
-	snake_(nullptr), 
-	food_(nullptr), 
-	mt_(std::random_device{}()), 
-	random_x_(0, constants::screen_width - grid_cell_side_), 
-	random_y_(0, constants::screen_height - grid_cell_side_), 
+	glyph_atlas_(std::make_unique<GlyphAtlas>()), 
+	score_text_(), 
+	controls_status_text_(), 
+	simulation_(std::make_unique<Simulation>(columns, rows, seed)), 
+	planner_(std::make_unique<IncrementalPlanner>()), 
+	metrics_(std::make_unique<Metrics>()), 
+	simulation_metrics_(std::make_unique<Metrics>()), 
+	board_(std::make_unique<BoardRenderer>()), 
+	recording_(std::make_unique<Replay>(columns, rows, seed)), 
+	metrics_csv_path_("metrics.csv"), 
+	wake_(false), 
+	frame_event_type_(0), 
+	frame_event_pending_(false), 
 	window_(nullptr), 
 	renderer_(nullptr), 
 	font_(nullptr)
 {
-	assert(constants::screen_width % grid_cell_side_ == 0 && constants::screen_height % grid_cell_side_ == 0);
-	grid_.resize((constants::screen_width / grid_cell_side_) * (constants::screen_height / grid_cell_side_));
-
-	int y_pos = 0;
-	int x_pos = 0;
-
-	for (std::size_t i = 0; i < grid_.size(); ++i)
-	{
-		GridCell& grid_cell = grid_[i];
-
-		grid_cell.box_.x = x_pos;
-		grid_cell.box_.y = y_pos;
-		grid_cell.box_.w = grid_cell_side_;
-		grid_cell.box_.h = grid_cell_side_;
-
-		//std::cout << "[" << x_pos << " " << y_pos << "] ";
-		//std::cout << "[" << i << "] ";
-
-		x_pos += grid_cell_side_;
-
-		if (i != 0 && (i + 1) % (constants::screen_width / grid_cell_side_) == 0)
-		{
-			x_pos = 0;
-			y_pos += grid_cell_side_;
-			//std::cout << std::endl;
-		}
-	}
-
-	snake_ = std::make_unique<Snake>(4, grid_cell_side_, this);
-
-	SpawnFood();
+	queued_turns_.reserve(max_queued_turns);
 }
 
 Game::~Game()
@@ -92,6 +139,14 @@ bool Game::Initialize()
 		return false;
 	}
 
+	frame_event_type_ = SDL_RegisterEvents(1);
+
+	if (frame_event_type_ == static_cast<Uint32>(-1))
+	{
+		printf("Frame event could not be registered! SDL Error: %s\n", SDL_GetError());
+		return false;
+	}
+
 	if (!SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0"))
 	{
 		printf("%s\n", "Warning: Texture filtering is not enabled!");
@@ -105,7 +160,7 @@ bool Game::Initialize()
 		return false;
 	}
 
-	renderer_ = SDL_CreateRenderer(window_, -1, SDL_RENDERER_ACCELERATED);
+	renderer_ = SDL_CreateRenderer(window_, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE | (vsync_ ? SDL_RENDERER_PRESENTVSYNC : 0));
 
 	if (renderer_ == nullptr)
 	{
@@ -115,6 +170,9 @@ bool Game::Initialize()
 
 	SDL_SetRenderDrawColor(renderer_, 0xFF, 0xFF, 0xFF, 0xFF);
 
+	const Grid& grid = simulation_->GetGrid();
+	board_->Initialize(renderer_, grid.Columns(), grid.Rows(), grid_cell_side_);
+
 	constexpr int img_flags = IMG_INIT_PNG;
 
 	if (!(IMG_Init(img_flags) & img_flags))
@@ -142,18 +200,23 @@ bool Game::InitInfoTextures()
 		return false;
 	}
 
-	SDL_Color text_color = { 0xFF, 0x00, 0x00, 0xFF };
+	UpdateScore();
+	UpdateControlsStatus();
 
-	const std::string score_text = "Score: " + std::to_string(score_);
+	return LoadTextTextures();
+}
 
-	std::stringstream ss;
+bool Game::LoadTextTextures()
+{
+	SDL_Color text_color = { 0xFF, 0x00, 0x00, 0xFF };
 
-	ss << "Autopilot: " << (autopilot_toggle_ ? "ON" : "OFF") << "        Regular A*: " << (shortest_path_toggle_ ? "ON" : "OFF") << "        Wrapped A*: " << (wrapped_shortest_path_toggle_ ? "ON" : "OFF");
+	if (!glyph_atlas_->Build(renderer_, font_))
+	{
+		return false;
+	}
 
-	score_info_->LoadFromText(renderer_, font_, score_text.c_str(), text_color);
-	controls_info_->LoadFromText(renderer_, font_, "Press to toggle: 'a' - autopilot       's' - A* path        'w' - wrapped A* 'ESC' - pause", text_color, 220);
+	controls_info_->LoadFromText(renderer_, font_, "Press to toggle: 'a' - autopilot       'h' - Hamiltonian autopilot       's' - A* path        'w' - wrapped A*        'f' - distance-field autopilot        't' - autopilot through edges        'l' - Monte Carlo lookahead autopilot        'm' - metrics 'ESC' - pause", text_color, 220);
 	toggle_info_->LoadFromText(renderer_, font_, "Press 'i' to toggle info.", text_color);
-	toggled_controls_info_->LoadFromText(renderer_, font_, ss.str().c_str(), text_color, 280);
 	game_over_info_->LoadFromText(renderer_, font_, "Press SPACE to restart.", text_color);
 
 	return true;
@@ -161,6 +224,8 @@ bool Game::InitInfoTextures()
 
 void Game::Finalize()
 {
+	board_->Free();
+
 	SDL_DestroyWindow(window_);
 	window_ = nullptr;
 
@@ -170,11 +235,10 @@ void Game::Finalize()
 	TTF_CloseFont(font_);
 	font_ = nullptr;
 
-	score_info_->FreeTexture();
 	controls_info_->FreeTexture();
 	toggle_info_->FreeTexture();
-	toggled_controls_info_->FreeTexture();
 	game_over_info_->FreeTexture();
+	glyph_atlas_->Free();
 
 	TTF_Quit();
 	IMG_Quit();
@@ -190,384 +254,785 @@ void Game::Run()
 	}
 
 	is_running_ = true;
-	
-	constexpr long double ms = 1.0 / 60.0;
 
-	std::uint64_t last_time = SDL_GetPerformanceCounter();
-	long double delta = 0.0;
+	const std::uint64_t frequency = SDL_GetPerformanceFrequency();
+	const std::uint64_t frame_interval = frame_rate_ > 0 ? frequency / frame_rate_ : 0;
+
+	std::uint64_t next_frame = SDL_GetPerformanceCounter();
+	std::uint64_t last_frame = next_frame;
+	std::uint64_t next_second = next_frame + frequency;
 
-	double timer = SDL_GetTicks();
+	next_step_ = next_frame;
+
+	// The first frame is published before the simulation thread exists, so there is always one to render.
+	Publish();
+	simulation_thread_ = std::thread(&Game::SimulationLoop, this);
 
 	int frames = 0;
-	int ticks = 0;
 
 	while (is_running_)
 	{
-		const std::uint64_t now = SDL_GetPerformanceCounter();
-		const long double elapsed = static_cast<long double>(now - last_time) / static_cast<long double>(SDL_GetPerformanceFrequency());
-		
-		last_time = now;
-		delta += elapsed;
-
 		HandleEvents();
 
-		while (delta >= ms)
+		if (frames_.Update())
 		{
-			Tick();
-			delta -= ms;
-			++ticks;
+			needs_render_ = true;
 		}
 
-		//printf("%Lf\n", delta / ms);
-		Render();
-		++frames;
+		std::uint64_t now = SDL_GetPerformanceCounter();
+
+		if (needs_render_ && now >= next_frame)
+		{
+			metrics_->Record(Metric::FRAME, ElapsedNs(last_frame));
+			last_frame = now;
+
+			Render();
+			metrics_->Record(Metric::RENDER, ElapsedNs(now));
+			needs_render_ = false;
+			++frames;
+
+			// Keep the frame cadence, but do not try to make up frames after a stall.
+			next_frame = now - next_frame > frame_interval ? now + frame_interval : next_frame + frame_interval;
+			now = SDL_GetPerformanceCounter();
+		}
 
-		if (SDL_GetTicks() - timer > 1000)
+		if (now >= next_second)
 		{
-			timer += 1000;
-			//printf("Frames: %d, Ticks: %d\n", frames, ticks);
+			next_second = now - next_second > frequency ? now + frequency : next_second + frequency;
+			metrics_->RollWindow();
+
+			if (metrics_toggle_)
+			{
+				UpdateMetricsInfo(frames);
+				needs_render_ = true;
+			}
+
 			frames = 0;
-			ticks = 0;
 		}
+
+		// New frames arrive as events, so only a pending render needs a deadline of its own.
+		std::uint64_t deadline = next_second;
+
+		if (needs_render_)
+		{
+			deadline = std::min(deadline, next_frame);
+		}
+
+		WaitUntil(deadline);
+	}
+
+	simulation_thread_.join();
+	metrics_->Merge(*simulation_metrics_);
+
+	if (!metrics_csv_path_.empty())
+	{
+		const std::size_t extension = metrics_csv_path_.rfind(".csv");
+		const std::string stem = extension == std::string::npos ? metrics_csv_path_ : metrics_csv_path_.substr(0, extension);
+
+		metrics_->WriteCsv(metrics_csv_path_, stem + "_histogram.csv");
+	}
+
+	if (!record_path_.empty() && player_ == nullptr)
+	{
+		recording_->Save(record_path_);
 	}
 }
 
-void Game::Stop()
+void Game::SimulationLoop()
 {
-	is_running_ = false;
+	const std::uint64_t frequency = SDL_GetPerformanceFrequency();
+
+	std::uint64_t next_second = SDL_GetPerformanceCounter() + frequency;
+
+	int ticks = 0;
+
+	while (is_running_)
+	{
+		bool changed = false;
+		KeyInput input;
+
+		while (input_.TryPop(input))
+		{
+			ApplyInput(input);
+			changed = true;
+		}
+
+		if (Tick())
+		{
+			++ticks;
+			changed = true;
+		}
+
+		const std::uint64_t now = SDL_GetPerformanceCounter();
+
+		if (now >= next_second)
+		{
+			next_second = now - next_second > frequency ? now + frequency : next_second + frequency;
+			simulation_metrics_->RollWindow();
+
+			if (metrics_toggle_)
+			{
+				UpdateSimulationMetricsInfo(ticks);
+				changed = true;
+			}
+
+			ticks = 0;
+		}
+
+		if (changed)
+		{
+			Publish();
+		}
+
+		std::uint64_t deadline = next_second;
+
+		if (!paused_ && (!game_over_ || player_ != nullptr))
+		{
+			deadline = std::min(deadline, next_step_);
+		}
+
+		WaitForInput(deadline);
+	}
 }
 
-void Game::GameOver()
+void Game::WaitForInput(std::uint64_t deadline)
 {
-	game_over_ = true;
+	const std::uint64_t frequency = SDL_GetPerformanceFrequency();
+
+	std::unique_lock<std::mutex> lock(wake_mutex_);
+
+	while (!wake_)
+	{
+		const std::uint64_t now = SDL_GetPerformanceCounter();
+
+		if (now >= deadline)
+		{
+			break;
+		}
+
+		// As in WaitUntil, the last two milliseconds are spun off, without holding the lock.
+		const std::uint64_t remaining_ms = (deadline - now) * 1000 / frequency;
+
+		if (remaining_ms > 2)
+		{
+			wake_condition_.wait_for(lock, std::chrono::milliseconds(remaining_ms - 2));
+		}
+		else
+		{
+			lock.unlock();
+			std::this_thread::yield();
+			lock.lock();
+		}
+	}
+
+	wake_ = false;
 }
 
-void Game::Reset()
+void Game::Publish()
 {
-	score_ = 0;
-	snake_.reset();
-	snake_ = std::make_unique<Snake>(4, grid_cell_side_, this);
-	tick_ms_ = 100;
-	game_over_ = false;
-	UpdateScore();
-	SpawnFood();
+	FrameState& frame = frames_.WriteBuffer();
+	const std::uint64_t drawn_serial = drawn_serial_.load(std::memory_order_acquire);
+
+	++frame_serial_;
+
+	std::size_t drawn = 0;
+
+	while (drawn < journal_.size() && journal_[drawn].serial_ <= drawn_serial)
+	{
+		++drawn;
+	}
+
+	journal_.erase(journal_.begin(), journal_.begin() + drawn);
+	RecordBoardChanges();
+
+	frame.serial_ = frame_serial_;
+	frame.clear_ = clear_serial_ > drawn_serial;
+	frame.changes_.clear();
+
+	for (const JournalEntry& entry : journal_)
+	{
+		frame.changes_.push_back(entry.change_);
+	}
+
+	frame.game_over_ = game_over_;
+	std::memcpy(frame.score_text_, score_text_, sizeof(score_text_));
+	std::memcpy(frame.controls_status_text_, controls_status_text_, sizeof(controls_status_text_));
+	frame.metrics_text_ = simulation_metrics_text_;
+
+	frames_.Publish();
+
+	if (!frame_event_pending_.exchange(true))
+	{
+		SDL_Event event = {};
+		event.type = frame_event_type_;
+		SDL_PushEvent(&event);
+	}
 }
 
-void Game::HandleEvents()
+void Game::RecordBoardChanges()
 {
-	SDL_Event e;
+	const Snake& snake = simulation_->GetSnake();
+	const std::uint64_t steps = simulation_->Steps();
+	const int food = simulation_->Food();
 
-	while (SDL_PollEvent(&e) != 0)
+	// Once the undrawn changes outnumber the cells, the render thread is better served by a whole board.
+	if (board_resync_ || steps < published_steps_ || steps > published_steps_ + 1 || journal_.size() > path_marks_.size())
 	{
-		if (e.type == SDL_QUIT)
-		{
-			Stop();
-		}
-		else if (game_over_ && e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_SPACE)
+		journal_.clear();
+		clear_serial_ = frame_serial_;
+		board_resync_ = false;
+
+		for (int index : published_path_)
 		{
-			autopilot_toggle_ = false;
-			Reset();
-			UpdateControlsStatus();
+			path_marks_[index] = 0;
 		}
-		else if (e.type == SDL_KEYUP && e.key.keysym.sym == SDLK_i)
+
+		published_path_.clear();
+
+		const int head = snake.GetHead();
+		snake.ForEachSegment([this, head](int index) { RecordCell(index, index == head ? CellColour::HEAD : CellColour::BODY); });
+
+		if (food != -1)
 		{
-			info_toggle_ = !info_toggle_;
+			RecordCell(food, CellColour::FOOD);
 		}
-		else if (!game_over_)
+	}
+	else
+	{
+		if (steps != published_steps_)
 		{
-			if (e.type == SDL_KEYUP && e.key.keysym.sym == SDLK_a)
+			const int released = simulation_->ReleasedCell();
+
+			if (released != -1 && !simulation_->IsOccupied(released))
 			{
-				shortest_path_toggle_ = false;
-				wrapped_shortest_path_toggle_ = false;
-				autopilot_toggle_ = !autopilot_toggle_;
-				shortest_path_cells_.clear();
-				UpdateControlsStatus();
+				RecordCell(released, CellColour::EMPTY);
 			}
-			else if (e.type == SDL_KEYUP && e.key.keysym.sym == SDLK_s)
+
+			if (snake.Length() > 1)
 			{
-				autopilot_toggle_ = false;
-				wrapped_shortest_path_toggle_ = false;
-				shortest_path_toggle_ = !shortest_path_toggle_;
-				shortest_path_cells_.clear();
-				UpdateControlsStatus();
+				RecordCell(published_head_, CellColour::BODY);
 			}
-			else if (e.type == SDL_KEYUP && e.key.keysym.sym == SDLK_w)
+
+			RecordCell(snake.GetHead(), CellColour::HEAD);
+		}
+
+		if (food != published_food_)
+		{
+			if (published_food_ != -1 && !simulation_->IsOccupied(published_food_))
 			{
-				autopilot_toggle_ = false;
-				shortest_path_toggle_ = false;
-				wrapped_shortest_path_toggle_ = !wrapped_shortest_path_toggle_;
-				shortest_path_cells_.clear();
-				UpdateControlsStatus();
+				RecordCell(published_food_, CellColour::EMPTY);
 			}
-			else if (e.type == SDL_KEYUP && e.key.keysym.sym == SDLK_ESCAPE)
+
+			if (food != -1)
 			{
-				paused_ = !paused_;
+				RecordCell(food, CellColour::FOOD);
 			}
 		}
-
-		snake_->HandleEvent(&e);
 	}
+
+	published_steps_ = steps;
+	published_head_ = snake.GetHead();
+	published_food_ = food;
+
+	RecordPathChanges();
 }
-	
-void Game::Tick()
+
+void Game::RecordPathChanges()
 {
-	const int current_ms = SDL_GetTicks();
-	
-	if (!paused_ && !game_over_ && current_ms - last_ms_ > tick_ms_)
-	{
-		last_ms_ = current_ms;
+	static const std::vector<int> no_path;
+	const std::vector<int>& path = autopilot_toggle_ ? simulation_->ShortestPathCells() : 
+		(shortest_path_toggle_ || wrapped_shortest_path_toggle_) ? planner_->Path() : no_path;
+	const int food = simulation_->Food();
 
-		GridCell* back_path_cell = nullptr;
+	next_path_.clear();
 
-		if (autopilot_toggle_ && !shortest_path_cells_.empty())
+	for (int index : path)
+	{
+		if (index != food && !simulation_->IsOccupied(index))
 		{
-			back_path_cell = shortest_path_cells_.back();
-			shortest_path_cells_.pop_back();
+			path_marks_[index] |= 2;
+			next_path_.push_back(index);
 		}
+	}
+
+	// Cells that left the path are emptied unless the snake or the food took them, which recoloured them already.
+	for (int index : published_path_)
+	{
+		if (!(path_marks_[index] & 2))
+		{
+			if (index != food && !simulation_->IsOccupied(index))
+			{
+				RecordCell(index, CellColour::EMPTY);
+			}
 
-		snake_->Tick(back_path_cell);
+			path_marks_[index] = 0;
+		}
+	}
 
-		if ((autopilot_toggle_ && shortest_path_cells_.empty()) || (shortest_path_toggle_ || wrapped_shortest_path_toggle_))
+	for (int index : next_path_)
+	{
+		if (!(path_marks_[index] & 1))
 		{
-			FindAStarPath(snake_->GetHead(), &grid_.at(food_->ConvertCellToGridIndex()), wrapped_shortest_path_toggle_);
+			RecordCell(index, CellColour::PATH);
 		}
+
+		path_marks_[index] = 1;
 	}
+
+	published_path_.swap(next_path_);
 }
 
-void Game::Render()
+void Game::RecordCell(int index, CellColour colour)
 {
-	SDL_RenderSetViewport(renderer_, NULL);
-	SDL_SetRenderDrawColor(renderer_, 0x00, 0x00, 0x00, 0xFF);
-	SDL_RenderClear(renderer_);
+	journal_.push_back({ { index, colour }, frame_serial_ });
+}
 
-	if (autopilot_toggle_ || shortest_path_toggle_ || wrapped_shortest_path_toggle_)
+void Game::WaitUntil(std::uint64_t deadline)
+{
+	const std::uint64_t frequency = SDL_GetPerformanceFrequency();
+
+	while (true)
 	{
-		for (const GridCell* cell : shortest_path_cells_)
+		const std::uint64_t now = SDL_GetPerformanceCounter();
+
+		if (now >= deadline || SDL_PollEvent(nullptr) != 0)
 		{
-			SDL_SetRenderDrawColor(renderer_, 0xFF, 0xFF, 0x00, 0xFF);
-			SDL_RenderFillRect(renderer_, &(cell->box_));
+			return;
 		}
-	}
-
-	snake_->Render(renderer_);
 
-	score_info_->Render(renderer_, constants::screen_width / 2 - (score_info_->Width() / 2), 0);
+		// Millisecond sleeps can overshoot, so the last two milliseconds before a deadline are spun off instead.
+		const std::uint64_t remaining_ms = (deadline - now) * 1000 / frequency;
 
-	if (game_over_)
-	{
-		game_over_info_->Render(renderer_, constants::screen_width / 2 - (game_over_info_->Width() / 2), constants::screen_height / 2 - (game_over_info_->Height() / 2));
+		if (remaining_ms > 2)
+		{
+			SDL_WaitEventTimeout(nullptr, static_cast<int>(remaining_ms - 2));
+		}
 	}
+}
 
-	toggle_info_->Render(renderer_, constants::screen_width / 2 - (toggle_info_->Width() / 2), constants::screen_height - toggle_info_->Height());
+void Game::Stop()
+{
+	is_running_ = false;
 
-	if (info_toggle_)
 	{
-		controls_info_->Render(renderer_, 10, constants::screen_height - controls_info_->Height());
+		std::lock_guard<std::mutex> lock(wake_mutex_);
+		wake_ = true;
 	}
 
-	toggled_controls_info_->Render(renderer_, constants::screen_width - toggled_controls_info_->Width() + 50, constants::screen_height - toggled_controls_info_->Height());
+	wake_condition_.notify_one();
+}
 
-	SDL_SetRenderDrawColor(renderer_, 0xFF, 0x00, 0x00, 0xFF);
-	SDL_RenderFillRect(renderer_, &food_->box_);
+void Game::GameOver()
+{
+	game_over_ = true;
+}
 
-	SDL_RenderPresent(renderer_);
+void Game::Reset()
+{
+	recording_->RecordReset();
+	simulation_->Reset();
+	planner_->Invalidate();
+	game_over_ = false;
+	board_resync_ = true;
+	queued_turns_.clear();
+	UpdateScore();
 }
 
-void Game::SpawnFood()
+void Game::HandleEvents()
 {
-	bool food_snake_collision = false;
-	int random_x = 0;
-	int random_y = 0;
+	SDL_Event e;
+	bool queued_input = false;
 
-	do
+	while (SDL_PollEvent(&e) != 0)
 	{
-		food_snake_collision = false;
+		if (e.type == frame_event_type_)
+		{
+			frame_event_pending_ = false;
+		}
+		else if (e.type == SDL_QUIT)
+		{
+			Stop();
+		}
+		else if (e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET)
+		{
+			// Texture contents, or after a device reset the textures themselves, are gone. The board keeps
+			// its cell colours and repaints every cell into the new texture.
+			board_->RecreateTexture(renderer_);
+			LoadTextTextures();
+			needs_render_ = true;
+		}
+		else if (e.type == SDL_KEYUP && e.key.keysym.sym == SDLK_i)
+		{
+			info_toggle_ = !info_toggle_;
+			needs_render_ = true;
+		}
+		else if (e.type == SDL_KEYUP && e.key.keysym.sym == SDLK_m)
+		{
+			metrics_toggle_ = !metrics_toggle_;
+			needs_render_ = true;
+		}
+		else if (e.type == SDL_KEYDOWN || e.type == SDL_KEYUP)
+		{
+			// A full queue means the simulation thread is far behind; dropping keys beats blocking the window.
+			input_.TryPush({ e.type, e.key.keysym.sym, e.key.repeat, SDL_GetPerformanceCounter() });
+			queued_input = true;
+		}
+		else
+		{
+			needs_render_ = true;
+		}
+	}
 
-		random_x = random_x_(mt_);
-		random_y = random_y_(mt_);
+	if (queued_input)
+	{
+		{
+			std::lock_guard<std::mutex> lock(wake_mutex_);
+			wake_ = true;
+		}
 
-		const int x_mod = random_x % grid_cell_side_;
-		const int y_mod = random_y % grid_cell_side_;
+		wake_condition_.notify_one();
+	}
+}
 
-		if (x_mod > (grid_cell_side_ / 2))
+void Game::ApplyInput(const KeyInput& input)
+{
+	if (player_ != nullptr && input.type_ == SDL_KEYDOWN && (input.sym_ == SDLK_PLUS || input.sym_ == SDLK_EQUALS || input.sym_ == SDLK_KP_PLUS))
+	{
+		playback_speed_ = std::min(playback_speed_ * 2.0, 1024.0);
+	}
+	else if (player_ != nullptr && input.type_ == SDL_KEYDOWN && (input.sym_ == SDLK_MINUS || input.sym_ == SDLK_KP_MINUS))
+	{
+		playback_speed_ = std::max(playback_speed_ / 2.0, 1.0 / 16.0);
+	}
+	else if (player_ == nullptr && game_over_ && input.type_ == SDL_KEYDOWN && input.sym_ == SDLK_SPACE)
+	{
+		if (autopilot_toggle_)
 		{
-			random_x = random_x - x_mod + grid_cell_side_;
+			recording_->RecordAutopilot(false, simulation_->GetAutopilotMode());
 		}
-		else
+
+		autopilot_toggle_ = false;
+		Reset();
+		UpdateControlsStatus();
+	}
+	else if (!game_over_)
+	{
+		if (player_ == nullptr && input.type_ == SDL_KEYUP && (input.sym_ == SDLK_a || input.sym_ == SDLK_h || input.sym_ == SDLK_f 
+			|| input.sym_ == SDLK_l))
+		{
+			const AutopilotMode autopilot_mode = input.sym_ == SDLK_a ? AutopilotMode::A_STAR : 
+				input.sym_ == SDLK_h ? AutopilotMode::HAMILTONIAN : 
+				input.sym_ == SDLK_f ? AutopilotMode::DISTANCE_FIELD : AutopilotMode::MONTE_CARLO;
+
+			shortest_path_toggle_ = false;
+			wrapped_shortest_path_toggle_ = false;
+			autopilot_toggle_ = !autopilot_toggle_ || simulation_->GetAutopilotMode() != autopilot_mode;
+			simulation_->SetAutopilotMode(autopilot_mode);
+			recording_->RecordAutopilot(autopilot_toggle_, autopilot_mode);
+			planner_->Invalidate();
+			UpdateControlsStatus();
+		}
+		else if (input.type_ == SDL_KEYUP && input.sym_ == SDLK_s)
 		{
-			random_x = random_x - x_mod;
+			autopilot_toggle_ = false;
+			wrapped_shortest_path_toggle_ = false;
+			shortest_path_toggle_ = !shortest_path_toggle_;
+			simulation_->ClearShortestPath();
+			planner_->Invalidate();
+			UpdateControlsStatus();
+		}
+		else if (input.type_ == SDL_KEYUP && input.sym_ == SDLK_w)
+		{
+			autopilot_toggle_ = false;
+			shortest_path_toggle_ = false;
+			wrapped_shortest_path_toggle_ = !wrapped_shortest_path_toggle_;
+			simulation_->ClearShortestPath();
+			planner_->Invalidate();
+			UpdateControlsStatus();
+		}
+		else if (player_ == nullptr && input.type_ == SDL_KEYUP && input.sym_ == SDLK_t)
+		{
+			simulation_->SetAutopilotWrapped(!simulation_->AutopilotWrapped());
+			UpdateControlsStatus();
 		}
+		else if (input.type_ == SDL_KEYUP && input.sym_ == SDLK_ESCAPE)
+		{
+			paused_ = !paused_;
+		}
+	}
+
+	Direction direction;
+
+	if (player_ == nullptr && input.type_ == SDL_KEYDOWN && input.repeat_ == 0 && KeyDirection(input.sym_, direction) 
+		&& queued_turns_.size() < max_queued_turns)
+	{
+		// Checked against the turn queued before it, since that is the direction the snake will have by then.
+		const Direction previous = queued_turns_.empty() ? simulation_->GetSnake().GetDirection() : queued_turns_.back().direction_;
 
-		if (y_mod > (grid_cell_side_ / 2))
+		if (direction != previous && !Opposite(direction, previous))
 		{
-			random_y = random_y - y_mod + grid_cell_side_;
+			queued_turns_.push_back({ direction, input.counter_ });
 		}
-		else
+	}
+}
+	
+bool Game::Tick()
+{
+	const std::uint64_t tick_start = SDL_GetPerformanceCounter();
+
+	if (paused_ || (game_over_ && player_ == nullptr) || tick_start < next_step_ || (player_ != nullptr && player_->Done()))
+	{
+		return false;
+	}
+
+	// Steps are scheduled on a fixed cadence from the previous deadline; after a pause or a stall the
+	// schedule restarts from now instead of bursting through the missed steps.
+	const double speed = player_ != nullptr ? playback_speed_ : 1.0;
+	const std::uint64_t interval = static_cast<std::uint64_t>(simulation_->TickMs() * SDL_GetPerformanceFrequency() / (1000.0 * speed));
+	next_step_ = tick_start - next_step_ > interval ? tick_start + interval : next_step_ + interval;
+
+	StepResult result = StepResult::MOVED;
+
+	if (player_ != nullptr)
+	{
+		const bool reset = player_->ResetPending();
+
+		result = player_->Advance(*simulation_);
+		UpdateControlsStatus();
+
+		if (reset)
 		{
-			random_y = random_y - y_mod;
+			planner_->Invalidate();
+			game_over_ = false;
+			board_resync_ = true;
+			UpdateScore();
 		}
+	}
+	else
+	{
+		Direction direction = simulation_->GetSnake().GetDirection();
+		std::uint64_t turn_counter = 0;
 
-		for (const GridCell* snake_segment : snake_->Segments())
+		if (!queued_turns_.empty())
 		{
-			if (snake_segment->box_.x == random_x && snake_segment->box_.y == random_y)
+			direction = queued_turns_.front().direction_;
+			turn_counter = queued_turns_.front().counter_;
+			queued_turns_.erase(queued_turns_.begin());
+		}
+
+		if (autopilot_toggle_)
+		{
+			const std::uint64_t path_start = SDL_GetPerformanceCounter();
+			if (simulation_->GetAutopilotMode() == AutopilotMode::MONTE_CARLO)
+			{
+				if (lookahead_ == nullptr)
+				{
+					lookahead_ = std::make_unique<MonteCarloPlanner>(std::thread::hardware_concurrency());
+				}
+
+				// Leave half of the tick for everything else.
+				lookahead_->SetTimeBudgetUs(simulation_->TickMs() * 500);
+				direction = lookahead_->ChooseDirection(*simulation_);
+			}
+			else
 			{
-				food_snake_collision = true;
-				break;
+				direction = simulation_->AutopilotDirection();
 			}
+			simulation_metrics_->Record(Metric::PATHFINDING, ElapsedNs(path_start));
+		}
+
+		if (direction != simulation_->GetSnake().GetDirection())
+		{
+			recording_->RecordTurn(direction);
+		}
+
+		recording_->RecordStep();
+		result = simulation_->Step(direction);
+
+		// Turns taken while the autopilot steers had no effect, so they are not counted.
+		if (turn_counter != 0 && !autopilot_toggle_)
+		{
+			simulation_metrics_->Record(Metric::INPUT_LATENCY, ElapsedNs(turn_counter));
 		}
 	}
-	while (food_snake_collision);
 
-	food_ = &grid_.at(ConvertXYToGridIndex(random_x, random_y));
-}
+	if (result == StepResult::ATE_FOOD)
+	{
+		UpdateScore();
+	}
+	else if (result == StepResult::COLLIDED || result == StepResult::WON)
+	{
+		GameOver();
+		simulation_metrics_->Record(Metric::TICK, ElapsedNs(tick_start));
+		return true;
+	}
 
-GridCell* Game::Food()
-{
-	return food_;
-}
+	if (shortest_path_toggle_ || wrapped_shortest_path_toggle_)
+	{
+		const std::uint64_t path_start = SDL_GetPerformanceCounter();
+		planner_->Plan(*simulation_, wrapped_shortest_path_toggle_);
+		simulation_metrics_->Record(Metric::PATHFINDING, ElapsedNs(path_start));
+	}
 
-std::vector<GridCell>& Game::Grid()
-{
-	return grid_;
-}
+	simulation_metrics_->Record(Metric::TICK, ElapsedNs(tick_start));
 
-void Game::IncrementScore()
-{
-	score_ += 10;
+	return true;
 }
 
-void Game::UpdateScore()
+void Game::SyncBoard(const FrameState& frame)
 {
-	score_info_->FreeTexture();
+	// A frame drawn again, e.g. for an overlay, has nothing new for the board.
+	if (frame.serial_ == drawn_serial_.load(std::memory_order_relaxed))
+	{
+		return;
+	}
 
-	const SDL_Color text_color = { 0xFF, 0x00, 0x00, 0xFF };
-	const std::string score_text = "Score: " + std::to_string(score_);
+	if (frame.clear_)
+	{
+		board_->Clear();
+	}
 
-	score_info_->LoadFromText(renderer_, font_, score_text.c_str(), text_color);
+	for (const CellChange& change : frame.changes_)
+	{
+		board_->SetCell(change.index_, change.colour_);
+	}
+
+	drawn_serial_.store(frame.serial_, std::memory_order_release);
 }
 
-void Game::UpdateControlsStatus()
+void Game::Render()
 {
-	toggled_controls_info_->FreeTexture();
+	const FrameState& frame = frames_.ReadBuffer();
 
-	SDL_Color text_color = { 0xFF, 0x00, 0x00, 0xFF };
+	SyncBoard(frame);
+	board_->Flush(renderer_);
 
-	const std::string score_text = "Score: " + std::to_string(score_);
+	SDL_RenderSetViewport(renderer_, NULL);
+	SDL_SetRenderDrawColor(renderer_, 0x00, 0x00, 0x00, 0xFF);
+	SDL_RenderClear(renderer_);
 
-	std::stringstream ss;
-	ss << "Autopilot: " << (autopilot_toggle_ ? "ON" : "OFF") << "        Regular A*: " << (shortest_path_toggle_ ? "ON" : "OFF") << "        Wrapped A*: " << (wrapped_shortest_path_toggle_ ? "ON" : "OFF");
-	toggled_controls_info_->LoadFromText(renderer_, font_, ss.str().c_str(), text_color, 280);
-}
+	board_->Render(renderer_, board_x_, board_y_);
 
-void Game::SpeedUp()
-{
-	int minimum_speed = 50;
+	const SDL_Color text_color = { 0xFF, 0x00, 0x00, 0xFF };
+
+	glyph_atlas_->Render(renderer_, frame.score_text_, constants::screen_width / 2 - (glyph_atlas_->Width(frame.score_text_) / 2), 0, text_color);
 
-	if (tick_ms_ > minimum_speed)
+	if (frame.game_over_)
 	{
-		--tick_ms_;
+		game_over_info_->Render(renderer_, constants::screen_width / 2 - (game_over_info_->Width() / 2), constants::screen_height / 2 - (game_over_info_->Height() / 2));
 	}
-}
 
-int Game::ConvertXYToGridIndex(int x, int y)
-{
-	const int x_pos = (x / grid_cell_side_);
-	const int y_pos = (y / grid_cell_side_);
-	
-	const int x_offset = constants::screen_width / grid_cell_side_;
+	toggle_info_->Render(renderer_, constants::screen_width / 2 - (toggle_info_->Width() / 2), constants::screen_height - toggle_info_->Height());
 
-	return y_pos * x_offset + x_pos;
+	if (info_toggle_)
+	{
+		controls_info_->Render(renderer_, 10, constants::screen_height - controls_info_->Height());
+	}
+
+	glyph_atlas_->Render(renderer_, frame.controls_status_text_, constants::screen_width - glyph_atlas_->Width(frame.controls_status_text_) - 10, 
+		constants::screen_height - glyph_atlas_->Height(frame.controls_status_text_), text_color);
+
+	if (metrics_toggle_)
+	{
+		const int metrics_y = glyph_atlas_->Height(frame.score_text_);
+
+		glyph_atlas_->Render(renderer_, metrics_text_.c_str(), 10, metrics_y, { 0xFF, 0xFF, 0xFF, 0xFF });
+		glyph_atlas_->Render(renderer_, frame.metrics_text_.c_str(), 10, metrics_y + glyph_atlas_->Height(metrics_text_.c_str()), { 0xFF, 0xFF, 0xFF, 0xFF });
+	}
+
+	SDL_RenderPresent(renderer_);
 }
 
-bool Game::AutopilotToggled() const
+void Game::UpdateScore()
 {
-	return autopilot_toggle_;
+	snprintf(score_text_, sizeof(score_text_), "Score: %d", simulation_->Score());
 }
 
-bool Game::WrappedShortestPathToggled() const
+void Game::UpdateControlsStatus()
 {
-	return wrapped_shortest_path_toggle_;
+	snprintf(controls_status_text_, sizeof(controls_status_text_), "Autopilot: %s\nRegular A*: %s\nWrapped A*: %s", AutopilotStatus(), 
+		shortest_path_toggle_ ? "ON" : "OFF", wrapped_shortest_path_toggle_ ? "ON" : "OFF");
 }
 
-bool Game::FindAStarPath(GridCell* start_cell, GridCell* target_cell, bool wrapped)
+void Game::UpdateMetricsInfo(int frames)
 {
-	for (GridCell& grid_cell : grid_)
+	std::stringstream ss;
+	ss << "FPS: " << frames;
+
+	for (Metric metric : { Metric::FRAME, Metric::RENDER })
 	{
-		grid_cell.graph_info_.parent_ = nullptr;
-		grid_cell.graph_info_.visited_ = false;
-		grid_cell.graph_info_.in_queue_ = false;
-		grid_cell.graph_info_.global_cost_ = std::numeric_limits<int>::max();
-		grid_cell.graph_info_.local_cost_ = std::numeric_limits<int>::max();
+		ss << "\n" << metrics_->Summary(metric, true);
 	}
 
-	auto queue_cmp = [](GridCell* c1, GridCell* c2) { return c1->graph_info_.global_cost_ > c2->graph_info_.global_cost_; };
-	std::priority_queue<GridCell*, std::vector<GridCell*>, decltype(queue_cmp)> min_heap{ queue_cmp };
+	metrics_text_ = ss.str();
+}
 
-	const std::vector<int> snake_indices = snake_->SnakeGridIndices();
-		
-	GridCell* current_cell = start_cell;
-	current_cell->graph_info_.local_cost_ = 0;
-	current_cell->graph_info_.global_cost_ = wrapped ? start_cell->GetShortestXYDistance(*target_cell) : start_cell->GetXYDistance(*target_cell);
-	
-	min_heap.push(start_cell);
+void Game::UpdateSimulationMetricsInfo(int ticks)
+{
+	std::stringstream ss;
+	ss << "Ticks/s: " << ticks;
 
-	while (!min_heap.empty() && min_heap.top() != target_cell)
+	for (Metric metric : { Metric::TICK, Metric::PATHFINDING, Metric::INPUT_LATENCY })
 	{
-		while (!min_heap.empty() && min_heap.top()->graph_info_.visited_)
-		{
-			min_heap.pop();
-		}
-
-		if (min_heap.empty())
-		{
-			break;
-		}
+		ss << "\n" << simulation_metrics_->Summary(metric, true);
+	}
 
-		current_cell = min_heap.top();
-		current_cell->graph_info_.visited_ = true;
+	simulation_metrics_text_ = ss.str();
+}
 
-		for (int index : current_cell->GetNeighboursIndices(wrapped))
-		{
-			GridCell* const neighbour_cell = &grid_.at(index);
+void Game::SetMetricsCsvPath(const std::string& path)
+{
+	metrics_csv_path_ = path;
+}
 
-			const bool is_snake_segment = std::find(std::begin(snake_indices), std::end(snake_indices), index) != std::end(snake_indices);	
+void Game::SetFrameRate(int frame_rate)
+{
+	frame_rate_ = std::max(0, frame_rate);
+}
 
-			if (is_snake_segment)
-			{
-				continue;
-			}
+void Game::SetVsync(bool vsync)
+{
+	vsync_ = vsync;
+}
 
-			const int lower_cost = current_cell->graph_info_.local_cost_ + (wrapped ? start_cell->GetShortestXYDistance(*target_cell) : start_cell->GetXYDistance(*target_cell));
+void Game::SetRecordPath(const std::string& path)
+{
+	record_path_ = path;
+}
 
-			if (lower_cost < neighbour_cell->graph_info_.local_cost_)
-			{
-				neighbour_cell->graph_info_.parent_ = current_cell;
-				neighbour_cell->graph_info_.local_cost_ = lower_cost;
-				neighbour_cell->graph_info_.global_cost_ = neighbour_cell->graph_info_.local_cost_ + (wrapped ? start_cell->GetShortestXYDistance(*target_cell) : start_cell->GetXYDistance(*target_cell));
-			}
+void Game::SetPlayback(std::unique_ptr<Replay> replay, double speed)
+{
+	playback_ = std::move(replay);
+	player_ = std::make_unique<ReplayPlayer>(*playback_);
+	playback_speed_ = speed;
+}
 
-			if (!neighbour_cell->graph_info_.visited_ && !is_snake_segment)
-			{
-				min_heap.push(neighbour_cell);
-			}
-		}
+const char* Game::AutopilotStatus() const
+{
+	if (player_ != nullptr ? !player_->AutopilotEnabled() : !autopilot_toggle_)
+	{
+		return "OFF";
 	}
-	
-	shortest_path_cells_.clear();
-	
-	GridCell* cell = target_cell;
 
-	while (cell != start_cell)
+	switch (simulation_->GetAutopilotMode())
 	{
-		shortest_path_cells_.push_back(cell);
-		cell = cell->graph_info_.parent_;
-		
-		if (cell == nullptr)
-		{
-			shortest_path_cells_.clear();
-			return false;
-		}
+		case AutopilotMode::HAMILTONIAN:
+			return "HAMILTONIAN";
+		case AutopilotMode::DISTANCE_FIELD:
+			return simulation_->AutopilotWrapped() ? "DISTANCE FIELD (WRAPPED)" : "DISTANCE FIELD";
+		case AutopilotMode::MONTE_CARLO:
+			return "MONTE CARLO";
+		default:
+			return simulation_->AutopilotWrapped() ? "A* (WRAPPED)" : "A*";
 	}
+}
 
-	return true;
+bool Game::AutopilotToggled() const
+{
+	return autopilot_toggle_;
 }
+
+bool Game::WrappedShortestPathToggled() const
+{
+	return wrapped_shortest_path_toggle_;
+}
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include "GlyphAtlas.hpp"
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+
+GlyphAtlas::GlyphAtlas() : texture_(nullptr), glyphs_(), line_skip_(0)
+{
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+	Free();
+}
+
+bool GlyphAtlas::Build(SDL_Renderer* renderer, TTF_Font* font)
+{
+	Free();
+
+	constexpr int atlas_width = 512;
+	constexpr SDL_Color white = { 0xFF, 0xFF, 0xFF, 0xFF };
+
+	std::array<SDL_Surface*, glyph_count> surfaces = {};
+
+	int x = 0;
+	int y = 0;
+	int row_height = 0;
+
+	// Lay the glyphs out in rows first so that the atlas surface is allocated once at its final size.
+	for (int i = 0; i < glyph_count; ++i)
+	{
+		const Uint16 c = static_cast<Uint16>(first_glyph + i);
+		int advance = 0;
+
+		surfaces[i] = TTF_RenderGlyph_Blended(font, c, white);
+
+		if (surfaces[i] == nullptr || TTF_GlyphMetrics(font, c, nullptr, nullptr, nullptr, nullptr, &advance) != 0)
+		{
+			printf("Unable to render glyph %d! SDL_ttf Error: %s\n", c, TTF_GetError());
+			glyphs_[i] = { { 0, 0, 0, 0 }, 0 };
+			continue;
+		}
+
+		if (x + surfaces[i]->w > atlas_width)
+		{
+			x = 0;
+			y += row_height;
+			row_height = 0;
+		}
+
+		glyphs_[i] = { { x, y, surfaces[i]->w, surfaces[i]->h }, advance };
+		x += surfaces[i]->w;
+		row_height = std::max(row_height, surfaces[i]->h);
+	}
+
+	SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, atlas_width, std::max(1, y + row_height), 32, SDL_PIXELFORMAT_RGBA32);
+
+	if (atlas != nullptr)
+	{
+		for (int i = 0; i < glyph_count; ++i)
+		{
+			if (surfaces[i] != nullptr)
+			{
+				SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+				SDL_BlitSurface(surfaces[i], nullptr, atlas, &glyphs_[i].source_);
+			}
+		}
+
+		texture_ = SDL_CreateTextureFromSurface(renderer, atlas);
+		SDL_FreeSurface(atlas);
+	}
+
+	for (SDL_Surface* surface : surfaces)
+	{
+		SDL_FreeSurface(surface);
+	}
+
+	if (texture_ == nullptr)
+	{
+		printf("Unable to create the glyph atlas! SDL Error: %s\n", SDL_GetError());
+		return false;
+	}
+
+	SDL_SetTextureBlendMode(texture_, SDL_BLENDMODE_BLEND);
+	line_skip_ = TTF_FontLineSkip(font);
+
+	return true;
+}
+
+void GlyphAtlas::Free()
+{
+	if (texture_ != nullptr)
+	{
+		SDL_DestroyTexture(texture_);
+		texture_ = nullptr;
+	}
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::Find(char c) const
+{
+	if (c < first_glyph || c > last_glyph)
+	{
+		return nullptr;
+	}
+
+	return &glyphs_[c - first_glyph];
+}
+
+void GlyphAtlas::Render(SDL_Renderer* renderer, const char* text, int x, int y, const SDL_Color& color) const
+{
+	if (texture_ == nullptr)
+	{
+		return;
+	}
+
+	SDL_SetTextureColorMod(texture_, color.r, color.g, color.b);
+
+	int pen_x = x;
+
+	for (const char* c = text; *c != '\0'; ++c)
+	{
+		if (*c == '\n')
+		{
+			pen_x = x;
+			y += line_skip_;
+			continue;
+		}
+
+		const Glyph* glyph = Find(*c);
+
+		if (glyph == nullptr)
+		{
+			continue;
+		}
+
+		const SDL_Rect destination = { pen_x, y, glyph->source_.w, glyph->source_.h };
+		SDL_RenderCopy(renderer, texture_, &glyph->source_, &destination);
+		pen_x += glyph->advance_;
+	}
+}
+
+int GlyphAtlas::Width(const char* text) const
+{
+	int width = 0;
+	int line_width = 0;
+
+	for (const char* c = text; *c != '\0'; ++c)
+	{
+		if (*c == '\n')
+		{
+			line_width = 0;
+			continue;
+		}
+
+		const Glyph* glyph = Find(*c);
+
+		if (glyph != nullptr)
+		{
+			line_width += glyph->advance_;
+			width = std::max(width, line_width);
+		}
+	}
+
+	return width;
+}
+
+int GlyphAtlas::Height(const char* text) const
+{
+	int lines = 1;
+
+	for (const char* c = text; *c != '\0'; ++c)
+	{
+		lines += *c == '\n';
+	}
+
+	return lines * line_skip_;
+}
\ No newline at end of file
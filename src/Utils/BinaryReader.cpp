@@ -0,0 +1,90 @@
+#include "Utils/BinaryReader.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+BinaryReader::BinaryReader(const std::uint8_t* data, std::size_t size) : data_(data), size_(size), offset_(0)
+{
+}
+
+std::size_t BinaryReader::Remaining() const
+{
+	return size_ - offset_;
+}
+
+bool BinaryReader::ReadBytes(void* data, std::size_t size)
+{
+	if (size > Remaining())
+	{
+		return false;
+	}
+
+	std::memcpy(data, data_ + offset_, size);
+	offset_ += size;
+
+	return true;
+}
+
+bool BinaryReader::ReadUint(std::uint64_t& value, int size)
+{
+	if (static_cast<std::size_t>(size) > Remaining())
+	{
+		return false;
+	}
+
+	value = 0;
+
+	for (int i = 0; i < size; ++i)
+	{
+		value |= static_cast<std::uint64_t>(data_[offset_++]) << (8 * i);
+	}
+
+	return true;
+}
+
+bool BinaryReader::ReadVarint(std::uint64_t& value)
+{
+	value = 0;
+
+	for (int shift = 0; shift < 64 && offset_ < size_; shift += 7)
+	{
+		const std::uint8_t byte = data_[offset_++];
+		value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+
+		if ((byte & 0x80) == 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool BinaryReader::ReadFile(const std::string& path, std::vector<std::uint8_t>& bytes)
+{
+	FILE* file = fopen(path.c_str(), "rb");
+
+	if (file == nullptr)
+	{
+		printf("Could not open %s!\n", path.c_str());
+		return false;
+	}
+
+	bytes.clear();
+
+	std::uint8_t buffer[4096];
+	std::size_t read = 0;
+
+	while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+	{
+		bytes.insert(bytes.end(), buffer, buffer + read);
+	}
+
+	fclose(file);
+
+	return true;
+}
\ No newline at end of file
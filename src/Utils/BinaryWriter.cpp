@@ -0,0 +1,52 @@
+#include "Utils/BinaryWriter.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+BinaryWriter::BinaryWriter(std::vector<std::uint8_t>& bytes) : bytes_(bytes)
+{
+}
+
+void BinaryWriter::WriteBytes(const void* data, std::size_t size)
+{
+	const std::uint8_t* first = static_cast<const std::uint8_t*>(data);
+	bytes_.insert(bytes_.end(), first, first + size);
+}
+
+void BinaryWriter::WriteUint(std::uint64_t value, int size)
+{
+	for (int i = 0; i < size; ++i)
+	{
+		bytes_.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+	}
+}
+
+void BinaryWriter::WriteVarint(std::uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		bytes_.push_back(static_cast<std::uint8_t>(value | 0x80));
+		value >>= 7;
+	}
+
+	bytes_.push_back(static_cast<std::uint8_t>(value));
+}
+
+bool BinaryWriter::WriteFile(const std::string& path, const std::vector<std::uint8_t>& bytes)
+{
+	FILE* file = fopen(path.c_str(), "wb");
+
+	if (file == nullptr)
+	{
+		printf("Could not open %s for writing!\n", path.c_str());
+		return false;
+	}
+
+	const bool written = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+	fclose(file);
+
+	return written;
+}
\ No newline at end of file
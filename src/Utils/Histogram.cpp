@@ -0,0 +1,124 @@
+#include "Utils/Histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+Histogram::Histogram()
+{
+	Clear();
+}
+
+void Histogram::Clear()
+{
+	counts_.fill(0);
+	count_ = 0;
+	total_ = 0;
+	max_ = 0;
+}
+
+std::size_t Histogram::BucketIndex(std::uint64_t value)
+{
+	if (value < 2 * sub_buckets)
+	{
+		return static_cast<std::size_t>(value);
+	}
+
+	std::size_t msb = 0;
+
+	while ((value >> msb) > 1)
+	{
+		++msb;
+	}
+
+	// The three bits below the most significant one pick the sub-bucket.
+	return (msb - 2) * sub_buckets + static_cast<std::size_t>((value >> (msb - 3)) & (sub_buckets - 1));
+}
+
+void Histogram::Record(std::uint64_t value)
+{
+	++counts_[BucketIndex(value)];
+	++count_;
+	total_ += value;
+	max_ = std::max(max_, value);
+}
+
+void Histogram::Merge(const Histogram& other)
+{
+	for (std::size_t i = 0; i < bucket_count; ++i)
+	{
+		counts_[i] += other.counts_[i];
+	}
+
+	count_ += other.count_;
+	total_ += other.total_;
+	max_ = std::max(max_, other.max_);
+}
+
+std::uint64_t Histogram::Count() const
+{
+	return count_;
+}
+
+std::uint64_t Histogram::Max() const
+{
+	return max_;
+}
+
+double Histogram::Mean() const
+{
+	return count_ == 0 ? 0.0 : static_cast<double>(total_) / static_cast<double>(count_);
+}
+
+std::uint64_t Histogram::Percentile(double percentile) const
+{
+	if (count_ == 0)
+	{
+		return 0;
+	}
+
+	const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(percentile / 100.0 * count_)));
+	std::uint64_t seen = 0;
+
+	for (std::size_t i = 0; i < bucket_count; ++i)
+	{
+		seen += counts_[i];
+
+		if (seen >= rank)
+		{
+			return std::min(BucketUpper(i), max_);
+		}
+	}
+
+	return max_;
+}
+
+std::uint64_t Histogram::BucketCount(std::size_t index) const
+{
+	return counts_[index];
+}
+
+std::uint64_t Histogram::BucketLower(std::size_t index)
+{
+	if (index < 2 * sub_buckets)
+	{
+		return index;
+	}
+
+	const std::size_t msb = index / sub_buckets + 2;
+
+	return static_cast<std::uint64_t>(sub_buckets + index % sub_buckets) << (msb - 3);
+}
+
+std::uint64_t Histogram::BucketUpper(std::size_t index)
+{
+	if (index < 2 * sub_buckets)
+	{
+		return index;
+	}
+
+	const std::size_t msb = index / sub_buckets + 2;
+
+	return BucketLower(index) + (std::uint64_t{ 1 } << (msb - 3)) - 1;
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "Utils/Metrics.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+const char* Metrics::Name(Metric metric)
+{
+	switch (metric)
+	{
+		case Metric::FRAME:
+			return "frame";
+		case Metric::TICK:
+			return "tick";
+		case Metric::RENDER:
+			return "render";
+		case Metric::PATHFINDING:
+			return "pathfinding";
+		case Metric::INPUT_LATENCY:
+			return "input_latency";
+		default:
+			return "unknown";
+	}
+}
+
+void Metrics::Record(Metric metric, std::uint64_t nanoseconds)
+{
+	total_[static_cast<std::size_t>(metric)].Record(nanoseconds);
+	window_[static_cast<std::size_t>(metric)].Record(nanoseconds);
+}
+
+void Metrics::RollWindow()
+{
+	for (std::size_t i = 0; i < metric_count; ++i)
+	{
+		last_window_[i] = window_[i];
+		window_[i].Clear();
+	}
+}
+
+void Metrics::Merge(const Metrics& other)
+{
+	for (std::size_t i = 0; i < metric_count; ++i)
+	{
+		total_[i].Merge(other.total_[i]);
+	}
+}
+
+const Histogram& Metrics::Total(Metric metric) const
+{
+	return total_[static_cast<std::size_t>(metric)];
+}
+
+const Histogram& Metrics::LastWindow(Metric metric) const
+{
+	return last_window_[static_cast<std::size_t>(metric)];
+}
+
+std::string Metrics::Summary(Metric metric, bool last_window) const
+{
+	const Histogram& histogram = last_window ? LastWindow(metric) : Total(metric);
+
+	char line[160];
+	snprintf(line, sizeof(line), "%-11s n %6llu  p50 %8.1f  p99 %8.1f  max %8.1f us", Name(metric), 
+		static_cast<unsigned long long>(histogram.Count()), histogram.Percentile(50.0) / 1000.0, 
+		histogram.Percentile(99.0) / 1000.0, histogram.Max() / 1000.0);
+
+	return line;
+}
+
+bool Metrics::WriteCsv(const std::string& path, const std::string& histogram_path) const
+{
+	FILE* file = fopen(path.c_str(), "w");
+
+	if (file == nullptr)
+	{
+		printf("Could not open %s for writing!\n", path.c_str());
+		return false;
+	}
+
+	fprintf(file, "metric,count,mean_us,p50_us,p90_us,p99_us,p999_us,max_us\n");
+
+	for (std::size_t i = 0; i < metric_count; ++i)
+	{
+		const Histogram& histogram = total_[i];
+
+		fprintf(file, "%s,%llu,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n", Name(static_cast<Metric>(i)), 
+			static_cast<unsigned long long>(histogram.Count()), histogram.Mean() / 1000.0, histogram.Percentile(50.0) / 1000.0, 
+			histogram.Percentile(90.0) / 1000.0, histogram.Percentile(99.0) / 1000.0, histogram.Percentile(99.9) / 1000.0, 
+			histogram.Max() / 1000.0);
+	}
+
+	fclose(file);
+
+	file = fopen(histogram_path.c_str(), "w");
+
+	if (file == nullptr)
+	{
+		printf("Could not open %s for writing!\n", histogram_path.c_str());
+		return false;
+	}
+
+	fprintf(file, "metric,lower_ns,upper_ns,count\n");
+
+	for (std::size_t i = 0; i < metric_count; ++i)
+	{
+		for (std::size_t bucket = 0; bucket < Histogram::bucket_count; ++bucket)
+		{
+			if (total_[i].BucketCount(bucket) != 0)
+			{
+				fprintf(file, "%s,%llu,%llu,%llu\n", Name(static_cast<Metric>(i)), 
+					static_cast<unsigned long long>(Histogram::BucketLower(bucket)), 
+					static_cast<unsigned long long>(Histogram::BucketUpper(bucket)), 
+					static_cast<unsigned long long>(total_[i].BucketCount(bucket)));
+			}
+		}
+	}
+
+	fclose(file);
+
+	return true;
+}
\ No newline at end of file
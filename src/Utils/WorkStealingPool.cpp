@@ -0,0 +1,151 @@
+#include "Utils/WorkStealingPool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+WorkStealingPool::WorkStealingPool(std::size_t worker_count) : 
+	task_(nullptr), 
+	job_generation_(0), 
+	busy_workers_(0), 
+	stopping_(false)
+{
+	worker_count = std::max<std::size_t>(worker_count, 1);
+
+	for (std::size_t i = 0; i < worker_count; ++i)
+	{
+		queues_.emplace_back(std::make_unique<WorkQueue>());
+	}
+
+	for (std::size_t i = 1; i < worker_count; ++i)
+	{
+		threads_.emplace_back(&WorkStealingPool::WorkerLoop, this, i);
+	}
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopping_ = true;
+	}
+
+	job_ready_.notify_all();
+
+	for (std::thread& thread : threads_)
+	{
+		thread.join();
+	}
+}
+
+std::size_t WorkStealingPool::WorkerCount() const
+{
+	return queues_.size();
+}
+
+void WorkStealingPool::Run(std::size_t task_count, const Task& task)
+{
+	const std::size_t worker_count = queues_.size();
+
+	// Contiguous blocks keep neighbouring tasks on one worker until somebody runs dry and steals.
+	for (std::size_t worker_index = 0; worker_index < worker_count; ++worker_index)
+	{
+		const std::size_t first = task_count * worker_index / worker_count;
+		const std::size_t last = task_count * (worker_index + 1) / worker_count;
+
+		std::lock_guard<std::mutex> lock(queues_[worker_index]->mutex_);
+		queues_[worker_index]->first_ = first;
+		queues_[worker_index]->last_ = last;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		task_ = &task;
+		busy_workers_ = threads_.size();
+		++job_generation_;
+	}
+
+	job_ready_.notify_all();
+
+	Drain(0);
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	job_done_.wait(lock, [this]() { return busy_workers_ == 0; });
+	task_ = nullptr;
+}
+
+void WorkStealingPool::WorkerLoop(std::size_t worker_index)
+{
+	std::uint64_t seen_generation = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			job_ready_.wait(lock, [this, seen_generation]() { return stopping_ || job_generation_ != seen_generation; });
+
+			if (stopping_)
+			{
+				return;
+			}
+
+			seen_generation = job_generation_;
+		}
+
+		Drain(worker_index);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			--busy_workers_;
+		}
+
+		job_done_.notify_one();
+	}
+}
+
+void WorkStealingPool::Drain(std::size_t worker_index)
+{
+	std::size_t task_index = 0;
+
+	while (PopTask(worker_index, task_index) || StealTask(worker_index, task_index))
+	{
+		(*task_)(task_index, worker_index);
+	}
+}
+
+bool WorkStealingPool::PopTask(std::size_t worker_index, std::size_t& task_index)
+{
+	WorkQueue& queue = *queues_[worker_index];
+	std::lock_guard<std::mutex> lock(queue.mutex_);
+
+	if (queue.first_ == queue.last_)
+	{
+		return false;
+	}
+
+	task_index = --queue.last_;
+
+	return true;
+}
+
+bool WorkStealingPool::StealTask(std::size_t worker_index, std::size_t& task_index)
+{
+	const std::size_t worker_count = queues_.size();
+
+	for (std::size_t offset = 1; offset < worker_count; ++offset)
+	{
+		WorkQueue& victim = *queues_[(worker_index + offset) % worker_count];
+		std::lock_guard<std::mutex> lock(victim.mutex_);
+
+		if (victim.first_ != victim.last_)
+		{
+			task_index = victim.first_++;
+
+			return true;
+		}
+	}
+
+	return false;
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "Utils/Xoshiro256.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace
+{
+	std::uint64_t RotateLeft(std::uint64_t value, int shift)
+	{
+		return (value << shift) | (value >> (64 - shift));
+	}
+} // namespace
+
+Xoshiro256::Xoshiro256(std::uint64_t seed) : state_()
+{
+	Seed(seed);
+}
+
+void Xoshiro256::Seed(std::uint64_t seed)
+{
+	for (std::uint64_t& word : state_)
+	{
+		word = SplitMix64(seed);
+		seed += 0x9e3779b97f4a7c15ULL;
+	}
+}
+
+Xoshiro256::result_type Xoshiro256::operator()()
+{
+	const std::uint64_t result = RotateLeft(state_[1] * 5, 7) * 9;
+	const std::uint64_t shifted = state_[1] << 17;
+
+	state_[2] ^= state_[0];
+	state_[3] ^= state_[1];
+	state_[1] ^= state_[2];
+	state_[0] ^= state_[3];
+	state_[2] ^= shifted;
+	state_[3] = RotateLeft(state_[3], 45);
+
+	return result;
+}
+
+const std::array<std::uint64_t, 4>& Xoshiro256::State() const
+{
+	return state_;
+}
+
+bool Xoshiro256::SetState(const std::array<std::uint64_t, 4>& state)
+{
+	if ((state[0] | state[1] | state[2] | state[3]) == 0)
+	{
+		return false;
+	}
+
+	state_ = state;
+
+	return true;
+}
\ No newline at end of file
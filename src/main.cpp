@@ -1,11 +1,119 @@
 #include "Game.hpp"
+#include "Core/Replay.hpp"
+#include "Utils/Constants.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
 
 int main(int argc, char* argv[])
 {
-	(void) argc;
-	(void) argv;
+	int columns = constants::default_grid_columns;
+	int rows = constants::default_grid_rows;
+	std::string metrics_csv_path = "metrics.csv";
+	int frame_rate = 60;
+	bool vsync = false;
+	bool seeded = false;
+	std::uint64_t seed = 0;
+	std::string record_path;
+	std::string play_path;
+	double speed = 1.0;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--columns") == 0 && i + 1 < argc)
+		{
+			columns = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--rows") == 0 && i + 1 < argc)
+		{
+			rows = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--metrics-csv") == 0 && i + 1 < argc)
+		{
+			metrics_csv_path = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc)
+		{
+			frame_rate = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--vsync") == 0)
+		{
+			vsync = true;
+		}
+		else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+		{
+			seed = std::strtoull(argv[++i], nullptr, 10);
+			seeded = true;
+		}
+		else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+		{
+			record_path = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--play") == 0 && i + 1 < argc)
+		{
+			play_path = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--speed") == 0 && i + 1 < argc)
+		{
+			speed = std::atof(argv[++i]);
+		}
+		else
+		{
+			printf("Usage: %s [--columns N] [--rows N] [--metrics-csv PATH] [--fps N] [--vsync] [--seed N] [--record PATH] [--play PATH [--speed X]]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	std::unique_ptr<Replay> replay;
+
+	if (!play_path.empty())
+	{
+		replay = std::make_unique<Replay>();
+
+		if (!replay->Load(play_path))
+		{
+			return 1;
+		}
+
+		columns = replay->Columns();
+		rows = replay->Rows();
+		seed = replay->Seed();
+		seeded = true;
+	}
+
+	if (columns < 1 || rows < 1)
+	{
+		printf("The board needs at least one column and one row.\n");
+		return 1;
+	}
+
+	if (speed <= 0.0)
+	{
+		printf("The playback speed must be positive.\n");
+		return 1;
+	}
+
+	if (!seeded)
+	{
+		seed = std::random_device{}();
+	}
+
+	std::unique_ptr<Game> game = std::make_unique<Game>(columns, rows, seed);
+	game->SetMetricsCsvPath(metrics_csv_path);
+	game->SetFrameRate(frame_rate);
+	game->SetVsync(vsync);
+	game->SetRecordPath(record_path);
+
+	if (replay != nullptr)
+	{
+		game->SetPlayback(std::move(replay), speed);
+	}
 
-	std::unique_ptr<Game> game = std::make_unique<Game>();
 	game->Run();
 
 	return 0;
@@ -0,0 +1,102 @@
+#include "Core/Arena.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+	void PrintUsage(const char* program)
+	{
+		printf("Usage: %s [--columns N] [--rows N] [--snakes N] [--length N] [--capacity N] [--food N] [--ticks N] [--threads N] [--seed N]\n", program);
+	}
+} // namespace
+
+// Runs a multi-snake arena headlessly as a scaling stress test for the simulation core. Prints the
+// throughput and a checksum of the final state, which is the same for any --threads.
+int main(int argc, char* argv[])
+{
+	int columns = 1024;
+	int rows = 1024;
+	std::size_t snakes = 4096;
+	std::size_t length = 8;
+	std::size_t capacity = 64;
+	std::size_t food = 16384;
+	std::uint64_t ticks = 1000;
+	std::size_t threads = std::thread::hardware_concurrency();
+	std::uint64_t seed = 1;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--columns") == 0 && i + 1 < argc)
+		{
+			columns = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--rows") == 0 && i + 1 < argc)
+		{
+			rows = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--snakes") == 0 && i + 1 < argc)
+		{
+			snakes = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--length") == 0 && i + 1 < argc)
+		{
+			length = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--capacity") == 0 && i + 1 < argc)
+		{
+			capacity = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--food") == 0 && i + 1 < argc)
+		{
+			food = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc)
+		{
+			ticks = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+		{
+			threads = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+		{
+			seed = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else
+		{
+			PrintUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (columns < 1 || rows < 1)
+	{
+		PrintUsage(argv[0]);
+		return 1;
+	}
+
+	Arena arena(columns, rows, snakes, length, capacity, food, seed, threads);
+	const auto start = std::chrono::steady_clock::now();
+	std::uint64_t snake_steps = 0;
+
+	for (std::uint64_t tick = 0; tick < ticks; ++tick)
+	{
+		snake_steps += arena.AliveCount();
+		arena.Tick();
+	}
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	printf("board: %dx%d, snakes: %zu, threads: %zu, ticks: %llu, seconds: %.3f, ticks/sec: %.1f, snake steps/sec: %.0f\n", columns, rows, 
+		arena.SnakeCount(), threads, static_cast<unsigned long long>(ticks), elapsed.count(), ticks / elapsed.count(), snake_steps / elapsed.count());
+	printf("alive: %zu, deaths: %llu, food eaten: %llu, checksum: %016llx\n", arena.AliveCount(), 
+		static_cast<unsigned long long>(arena.Deaths()), static_cast<unsigned long long>(arena.FoodEaten()), 
+		static_cast<unsigned long long>(arena.Checksum()));
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,241 @@
+#include "Core/MonteCarloPlanner.hpp"
+#include "Core/Replay.hpp"
+#include "Core/Simulation.hpp"
+#include "Utils/Constants.hpp"
+#include "Utils/WorkStealingPool.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	enum class GameEnd
+	{
+		COLLISION, BOARD_FULL, STEP_LIMIT
+	};
+
+	struct GameReport
+	{
+		std::uint64_t seed_;
+		int score_;
+		std::uint64_t steps_;
+		GameEnd end_;
+	};
+
+	const char* GameEndName(GameEnd end)
+	{
+		switch (end)
+		{
+			case GameEnd::COLLISION:
+				return "collision";
+			case GameEnd::BOARD_FULL:
+				return "board_full";
+			case GameEnd::STEP_LIMIT:
+				return "step_limit";
+		}
+
+		return "unknown";
+	}
+
+	struct BatchOptions
+	{
+		int columns_;
+		int rows_;
+		std::uint64_t max_steps_;
+		AutopilotMode autopilot_mode_;
+		bool wrapped_;
+		const char* record_prefix_;
+		int rollouts_;
+	};
+
+	GameReport PlayGame(std::uint64_t seed, const BatchOptions& options)
+	{
+		Simulation simulation(options.columns_, options.rows_, seed);
+		simulation.SetAutopilotMode(options.autopilot_mode_);
+		simulation.SetAutopilotWrapped(options.wrapped_);
+		GameReport report = { seed, 0, 0, GameEnd::STEP_LIMIT };
+
+		// Games already run in parallel, so each one plays its rollouts on its own thread.
+		std::unique_ptr<MonteCarloPlanner> planner;
+
+		if (options.autopilot_mode_ == AutopilotMode::MONTE_CARLO)
+		{
+			planner = std::make_unique<MonteCarloPlanner>(1);
+			planner->SetRollouts(options.rollouts_);
+		}
+
+		Replay replay(options.columns_, options.rows_, seed);
+		const bool recording = options.record_prefix_ != nullptr;
+
+		if (recording)
+		{
+			replay.RecordAutopilot(true, options.autopilot_mode_);
+		}
+
+		while (!simulation.GameOver() && report.steps_ < options.max_steps_)
+		{
+			const Direction direction = planner != nullptr ? planner->ChooseDirection(simulation) : simulation.AutopilotDirection();
+
+			if (recording)
+			{
+				if (direction != simulation.GetSnake().GetDirection())
+				{
+					replay.RecordTurn(direction);
+				}
+
+				replay.RecordStep();
+			}
+
+			// The step that runs into the snake never moves it, so it is not counted.
+			if (simulation.Step(direction) != StepResult::COLLIDED)
+			{
+				++report.steps_;
+			}
+		}
+
+		if (simulation.GameOver())
+		{
+			report.end_ = simulation.Won() ? GameEnd::BOARD_FULL : GameEnd::COLLISION;
+		}
+
+		if (recording && report.end_ == GameEnd::COLLISION)
+		{
+			replay.Save(std::string(options.record_prefix_) + std::to_string(seed) + ".snkr");
+		}
+
+		report.score_ = simulation.Score();
+
+		return report;
+	}
+
+	void PrintUsage(const char* program)
+	{
+		printf("Usage: %s [--games N] [--seed FIRST_SEED] [--columns N] [--rows N] [--threads N] [--max-steps N] [--autopilot astar|hamiltonian|field|montecarlo] [--rollouts N] [--wrapped] [--record-deaths PREFIX]\n", program);
+	}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	std::uint64_t games = 1000;
+	std::uint64_t first_seed = 1;
+	std::size_t threads = std::thread::hardware_concurrency();
+	BatchOptions options = { constants::default_grid_columns, constants::default_grid_rows, 1000000, AutopilotMode::A_STAR, false, nullptr, 64 };
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--games") == 0 && i + 1 < argc)
+		{
+			games = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+		{
+			first_seed = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+		{
+			threads = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--max-steps") == 0 && i + 1 < argc)
+		{
+			options.max_steps_ = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--columns") == 0 && i + 1 < argc)
+		{
+			options.columns_ = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--rows") == 0 && i + 1 < argc)
+		{
+			options.rows_ = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--autopilot") == 0 && i + 1 < argc && std::strcmp(argv[i + 1], "astar") == 0)
+		{
+			options.autopilot_mode_ = AutopilotMode::A_STAR;
+			++i;
+		}
+		else if (std::strcmp(argv[i], "--autopilot") == 0 && i + 1 < argc && std::strcmp(argv[i + 1], "hamiltonian") == 0)
+		{
+			options.autopilot_mode_ = AutopilotMode::HAMILTONIAN;
+			++i;
+		}
+		else if (std::strcmp(argv[i], "--autopilot") == 0 && i + 1 < argc && std::strcmp(argv[i + 1], "field") == 0)
+		{
+			options.autopilot_mode_ = AutopilotMode::DISTANCE_FIELD;
+			++i;
+		}
+		else if (std::strcmp(argv[i], "--autopilot") == 0 && i + 1 < argc && std::strcmp(argv[i + 1], "montecarlo") == 0)
+		{
+			options.autopilot_mode_ = AutopilotMode::MONTE_CARLO;
+			++i;
+		}
+		else if (std::strcmp(argv[i], "--rollouts") == 0 && i + 1 < argc)
+		{
+			options.rollouts_ = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--wrapped") == 0)
+		{
+			options.wrapped_ = true;
+		}
+		else if (std::strcmp(argv[i], "--record-deaths") == 0 && i + 1 < argc)
+		{
+			options.record_prefix_ = argv[++i];
+		}
+		else
+		{
+			PrintUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (options.columns_ < 1 || options.rows_ < 1 || options.rollouts_ < 1)
+	{
+		PrintUsage(argv[0]);
+		return 1;
+	}
+
+	std::vector<GameReport> reports(games);
+	WorkStealingPool pool(threads);
+
+	const auto start = std::chrono::steady_clock::now();
+
+	pool.Run(games, [&reports, first_seed, &options](std::size_t task_index, std::size_t)
+	{
+		reports[task_index] = PlayGame(first_seed + task_index, options);
+	});
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::uint64_t total_steps = 0;
+	long long total_score = 0;
+	std::uint64_t completed_games = 0;
+	std::uint64_t completed_steps = 0;
+
+	printf("seed,score,steps,end\n");
+
+	for (const GameReport& report : reports)
+	{
+		printf("%llu,%d,%llu,%s\n", static_cast<unsigned long long>(report.seed_), report.score_, static_cast<unsigned long long>(report.steps_), GameEndName(report.end_));
+		total_steps += report.steps_;
+		total_score += report.score_;
+
+		if (report.end_ == GameEnd::BOARD_FULL)
+		{
+			++completed_games;
+			completed_steps += report.steps_;
+		}
+	}
+
+	fprintf(stderr, "games: %llu, threads: %zu, seconds: %.3f, games/sec: %.1f, steps/sec: %.0f, mean score: %.1f\n", 
+		static_cast<unsigned long long>(games), pool.WorkerCount(), elapsed.count(), games / elapsed.count(), total_steps / elapsed.count(), 
+		games == 0 ? 0.0 : static_cast<double>(total_score) / games);
+	fprintf(stderr, "completed: %llu, mean steps to completion: %.1f\n", static_cast<unsigned long long>(completed_games), 
+		completed_games == 0 ? 0.0 : static_cast<double>(completed_steps) / completed_games);
+
+	return 0;
+}
\ No newline at end of file
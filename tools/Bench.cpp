@@ -0,0 +1,366 @@
+#include "Core/Bitboard.hpp"
+#include "Core/DistanceField.hpp"
+#include "Core/FloodFill.hpp"
+#include "Core/Grid.hpp"
+#include "Core/HamiltonianCycle.hpp"
+#include "Core/MonteCarloPlanner.hpp"
+#include "Core/Simulation.hpp"
+#include "Core/VectorEnvironment.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct BenchCase
+	{
+		int columns_;
+		int rows_;
+		std::size_t snake_length_;
+	};
+
+	struct BenchOptions
+	{
+		std::vector<std::pair<int, int>> sizes_;
+		std::vector<double> lengths_;
+		double min_seconds_;
+		std::uint64_t seed_;
+		std::size_t threads_;
+	};
+
+	// Keeps the compiler from discarding the measured work.
+	volatile std::uint64_t sink = 0;
+
+	// Runs operation(iterations) with a doubling iteration count until one run takes at least min_seconds.
+	template <typename Operation>
+	void Measure(const char* name, const BenchCase& bench_case, double min_seconds, Operation operation)
+	{
+		std::uint64_t iterations = 1;
+
+		while (true)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			operation(iterations);
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+			if (elapsed.count() >= min_seconds || iterations >= (std::uint64_t{ 1 } << 40))
+			{
+				printf("%s,%d,%d,%zu,%llu,%.1f\n", name, bench_case.columns_, bench_case.rows_, bench_case.snake_length_, 
+					static_cast<unsigned long long>(iterations), elapsed.count() * 1e9 / iterations);
+				fflush(stdout);
+				return;
+			}
+
+			iterations *= 2;
+		}
+	}
+
+	// A snake laid along the Hamiltonian cycle from its first cell, head first, so that the Hamiltonian
+	// autopilot can keep it moving for as long as the benchmark needs.
+	std::vector<int> CycleBody(int columns, int rows, std::size_t length)
+	{
+		HamiltonianCycle cycle;
+		cycle.Build(columns, rows);
+
+		std::vector<int> body(length);
+		int cell = 0;
+
+		for (std::size_t i = length; i-- > 0;)
+		{
+			body[i] = cell;
+			cell = cycle.Successor(cell);
+		}
+
+		return body;
+	}
+
+	Direction HeadDirection(const Grid& grid, const std::vector<int>& body)
+	{
+		for (Direction direction : { Direction::LEFT, Direction::RIGHT, Direction::UP, Direction::DOWN })
+		{
+			if (body.size() > 1 && grid.Neighbour(body[1], direction, true) == body[0])
+			{
+				return direction;
+			}
+		}
+
+		return Direction::RIGHT;
+	}
+
+	void RunCase(const BenchCase& bench_case, const BenchOptions& options)
+	{
+		Simulation simulation(bench_case.columns_, bench_case.rows_, options.seed_);
+		const std::vector<int> body = CycleBody(bench_case.columns_, bench_case.rows_, bench_case.snake_length_);
+		const Direction direction = HeadDirection(simulation.GetGrid(), body);
+
+		simulation.Reset(body, direction);
+
+		// The same fixed set of free target cells for every A* run.
+		std::mt19937_64 mt(options.seed_);
+		std::vector<int> targets;
+
+		for (int i = 0; i < 64 && !simulation.FreeCells().Empty(); ++i)
+		{
+			std::uniform_int_distribution<std::size_t> random_position(0, simulation.FreeCells().Size() - 1);
+			targets.push_back(simulation.FreeCells().At(random_position(mt)));
+		}
+
+		if (!targets.empty())
+		{
+			for (bool wrapped : { false, true })
+			{
+				Measure(wrapped ? "astar_wrapped" : "astar_plain", bench_case, options.min_seconds_, [&](std::uint64_t iterations)
+				{
+					for (std::uint64_t i = 0; i < iterations; ++i)
+					{
+						simulation.FindAStarPath(simulation.GetSnake().GetHead(), targets[i % targets.size()], wrapped);
+						sink += simulation.ShortestPathCells().size();
+					}
+				});
+			}
+
+			DistanceField distance_field;
+
+			Measure("distance_field", bench_case, options.min_seconds_, [&](std::uint64_t iterations)
+			{
+				for (std::uint64_t i = 0; i < iterations; ++i)
+				{
+					distance_field.Compute(simulation.GetGrid(), simulation.Occupancy(), targets[i % targets.size()], false);
+					sink += distance_field.Distance(simulation.GetSnake().GetHead());
+				}
+			});
+
+			const FloodFill flood_fill(bench_case.columns_, bench_case.rows_);
+			Bitboard open_cells;
+			open_cells.AssignComplement(simulation.Occupancy());
+			Bitboard region(simulation.GetGrid().CellCount());
+
+			Measure("flood_fill", bench_case, options.min_seconds_, [&](std::uint64_t iterations)
+			{
+				for (std::uint64_t i = 0; i < iterations; ++i)
+				{
+					region.Clear();
+					region.Set(targets[i % targets.size()]);
+					flood_fill.Fill(open_cells, region, true);
+					sink += region.Count();
+				}
+			});
+
+			// One autopilot decision: 64 rollouts of 64 steps from each safe move, spread over the pool.
+			MonteCarloPlanner lookahead(options.threads_);
+			lookahead.SetRollouts(64);
+
+			Measure("monte_carlo", bench_case, options.min_seconds_, [&](std::uint64_t iterations)
+			{
+				for (std::uint64_t i = 0; i < iterations; ++i)
+				{
+					sink += static_cast<std::uint64_t>(lookahead.ChooseDirection(simulation));
+				}
+			});
+
+			Measure("spawn_food", bench_case, options.min_seconds_, [&](std::uint64_t iterations)
+			{
+				for (std::uint64_t i = 0; i < iterations; ++i)
+				{
+					simulation.SpawnFood();
+					sink += simulation.Food();
+				}
+			});
+		}
+
+		simulation.Reset(body, direction);
+		simulation.SetAutopilotMode(AutopilotMode::HAMILTONIAN);
+
+		Measure("step_hamiltonian", bench_case, options.min_seconds_, [&](std::uint64_t iterations)
+		{
+			for (std::uint64_t i = 0; i < iterations; ++i)
+			{
+				if (simulation.GameOver())
+				{
+					simulation.Reset(body, direction);
+				}
+
+				sink += static_cast<std::uint64_t>(simulation.Step(simulation.AutopilotDirection()));
+			}
+		});
+	}
+
+	void RunNeighbours(int columns, int rows, const BenchOptions& options)
+	{
+		const Grid grid(columns, rows);
+		const BenchCase bench_case = { columns, rows, 0 };
+		const std::uint64_t cell_count = grid.CellCount();
+
+		for (bool wrapped : { false, true })
+		{
+			Measure(wrapped ? "neighbours_wrapped" : "neighbours_plain", bench_case, options.min_seconds_, [&](std::uint64_t iterations)
+			{
+				std::uint64_t index = 0;
+
+				for (std::uint64_t i = 0; i < iterations; ++i)
+				{
+					for (int neighbour_index : grid.Neighbours(static_cast<int>(index), wrapped))
+					{
+						sink += neighbour_index;
+					}
+
+					index = index + 1 == cell_count ? 0 : index + 1;
+				}
+			});
+		}
+	}
+
+	// One lockstep step of a batch of games with random actions, including the observation writes and resets.
+	void RunVectorEnvironment(int columns, int rows, const BenchOptions& options)
+	{
+		constexpr std::size_t game_count = 64;
+		const BenchCase bench_case = { columns, rows, 0 };
+
+		// 64 games of the largest boards would not fit in memory.
+		if (static_cast<std::size_t>(columns) * rows > (std::size_t{ 1 } << 18))
+		{
+			return;
+		}
+
+		VectorEnvironment environment(game_count, columns, rows, options.seed_, 0, options.threads_);
+
+		std::vector<std::uint8_t> observations(game_count * environment.ObservationSize());
+		std::vector<std::uint8_t> actions(game_count);
+		std::vector<float> rewards(game_count);
+		std::vector<std::uint8_t> dones(game_count);
+		std::mt19937_64 mt(options.seed_);
+
+		environment.Reset(observations.data());
+
+		Measure("vector_env_step", bench_case, options.min_seconds_, [&](std::uint64_t iterations)
+		{
+			for (std::uint64_t i = 0; i < iterations; ++i)
+			{
+				for (std::uint8_t& action : actions)
+				{
+					action = static_cast<std::uint8_t>(mt() & 3);
+				}
+
+				environment.Step(actions.data(), observations.data(), rewards.data(), dones.data());
+				sink += dones[i % game_count];
+			}
+		});
+	}
+
+	bool ParseSizes(const char* text, std::vector<std::pair<int, int>>& sizes)
+	{
+		sizes.clear();
+
+		while (*text != '\0')
+		{
+			char* end = nullptr;
+			const long columns = std::strtol(text, &end, 10);
+
+			if (*end != 'x')
+			{
+				return false;
+			}
+
+			const long rows = std::strtol(end + 1, &end, 10);
+
+			if (columns < 2 || rows < 2 || !HamiltonianCycle::Exists(columns, rows))
+			{
+				return false;
+			}
+
+			sizes.emplace_back(static_cast<int>(columns), static_cast<int>(rows));
+			text = *end == ',' ? end + 1 : end;
+		}
+
+		return !sizes.empty();
+	}
+
+	bool ParseLengths(const char* text, std::vector<double>& lengths)
+	{
+		lengths.clear();
+
+		while (*text != '\0')
+		{
+			char* end = nullptr;
+			const double length = std::strtod(text, &end);
+
+			if (end == text || length <= 0.0)
+			{
+				return false;
+			}
+
+			lengths.push_back(length);
+			text = *end == ',' ? end + 1 : end;
+		}
+
+		return !lengths.empty();
+	}
+
+	void PrintUsage(const char* program)
+	{
+		printf("Usage: %s [--sizes 24x18,128x128,...] [--lengths 4,0.25,...] [--min-time SECONDS] [--seed N] [--threads N]\n", program);
+		printf("Lengths below 1 are fractions of the board. Sizes need an even column or row count.\n");
+	}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	BenchOptions options = { { { 24, 18 }, { 128, 128 }, { 512, 512 }, { 2048, 2048 } }, { 4, 0.1, 0.5 }, 0.2, 1, std::thread::hardware_concurrency() };
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--sizes") == 0 && i + 1 < argc && ParseSizes(argv[i + 1], options.sizes_))
+		{
+			++i;
+		}
+		else if (std::strcmp(argv[i], "--lengths") == 0 && i + 1 < argc && ParseLengths(argv[i + 1], options.lengths_))
+		{
+			++i;
+		}
+		else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc)
+		{
+			options.min_seconds_ = std::strtod(argv[++i], nullptr);
+		}
+		else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+		{
+			options.seed_ = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+		{
+			options.threads_ = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else
+		{
+			PrintUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	printf("benchmark,columns,rows,snake_length,iterations,ns_per_op\n");
+
+	for (const std::pair<int, int>& size : options.sizes_)
+	{
+		const std::size_t cell_count = static_cast<std::size_t>(size.first) * size.second;
+
+		RunNeighbours(size.first, size.second, options);
+		RunVectorEnvironment(size.first, size.second, options);
+
+		for (double length : options.lengths_)
+		{
+			std::size_t snake_length = length < 1.0 ? static_cast<std::size_t>(length * cell_count) : static_cast<std::size_t>(length);
+			snake_length = std::min(std::max<std::size_t>(snake_length, 2), cell_count - 1);
+
+			RunCase({ size.first, size.second, snake_length }, options);
+		}
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "Core/Replay.hpp"
+#include "Core/ReplayPlayer.hpp"
+#include "Core/Simulation.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+	void PrintUsage(const char* program)
+	{
+		printf("Usage: %s REPLAY_FILE [--repeat N] [--quiet]\n", program);
+	}
+} // namespace
+
+// Plays a recorded replay headlessly as fast as possible, printing how each recorded game ended.
+// With --repeat the replay is played several times over, as a fixed benchmark workload.
+int main(int argc, char* argv[])
+{
+	const char* path = nullptr;
+	std::uint64_t repeat = 1;
+	bool quiet = false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc)
+		{
+			repeat = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (std::strcmp(argv[i], "--quiet") == 0)
+		{
+			quiet = true;
+		}
+		else if (path == nullptr && argv[i][0] != '-')
+		{
+			path = argv[i];
+		}
+		else
+		{
+			PrintUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	Replay replay;
+
+	if (path == nullptr || !replay.Load(path))
+	{
+		PrintUsage(argv[0]);
+		return 1;
+	}
+
+	if (replay.Columns() < 1 || replay.Rows() < 1)
+	{
+		printf("The replay has no board.\n");
+		return 1;
+	}
+
+	if (!quiet)
+	{
+		printf("game,score,steps,end\n");
+	}
+
+	std::uint64_t total_steps = 0;
+	const auto start = std::chrono::steady_clock::now();
+
+	for (std::uint64_t run = 0; run < repeat; ++run)
+	{
+		Simulation simulation(replay.Columns(), replay.Rows(), replay.Seed());
+		ReplayPlayer player(replay);
+		int game = 0;
+		std::uint64_t game_start = 0;
+
+		while (!player.Done())
+		{
+			if (player.ResetPending() && !quiet && run == 0)
+			{
+				printf("%d,%d,%llu,%s\n", game, simulation.Score(), static_cast<unsigned long long>(player.StepIndex() - game_start), 
+					simulation.GameOver() ? (simulation.Won() ? "board_full" : "collision") : "restarted");
+				++game;
+				game_start = player.StepIndex();
+			}
+
+			player.Advance(simulation);
+		}
+
+		if (!quiet && run == 0)
+		{
+			printf("%d,%d,%llu,%s\n", game, simulation.Score(), static_cast<unsigned long long>(player.StepIndex() - game_start), 
+				simulation.GameOver() ? (simulation.Won() ? "board_full" : "collision") : "unfinished");
+		}
+
+		total_steps += replay.StepCount();
+	}
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	fprintf(stderr, "board: %dx%d, seed: %llu, steps: %llu, runs: %llu, seconds: %.3f, steps/sec: %.0f\n", replay.Columns(), replay.Rows(), 
+		static_cast<unsigned long long>(replay.Seed()), static_cast<unsigned long long>(replay.StepCount()), 
+		static_cast<unsigned long long>(repeat), elapsed.count(), total_steps / elapsed.count());
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,295 @@
+#include "Core/Direction.hpp"
+#include "Core/Simulation.hpp"
+#include "Utils/BinaryWriter.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+	// The four RNG words close every snapshot, right after the autopilot plan.
+	constexpr std::size_t rng_bytes = 32;
+
+	void PrintUsage(const char* program)
+	{
+		printf("Usage: %s [--columns N] [--rows N] [--games N] [--seed N]\n", program);
+	}
+
+	void WritePlan(std::vector<std::uint8_t>& bytes, const std::vector<int>& plan)
+	{
+		BinaryWriter writer(bytes);
+		writer.WriteVarint(plan.size());
+
+		for (int index : plan)
+		{
+			writer.WriteVarint(static_cast<std::uint64_t>(index));
+		}
+	}
+
+	// The snapshot with its saved plan swapped for another one, food first as Snapshot writes it.
+	std::vector<std::uint8_t> WithPlan(const std::vector<std::uint8_t>& snapshot, const std::vector<int>& saved_plan, const std::vector<int>& plan)
+	{
+		std::vector<std::uint8_t> saved_bytes;
+		WritePlan(saved_bytes, saved_plan);
+
+		const std::size_t prefix_size = snapshot.size() - rng_bytes - saved_bytes.size();
+		std::vector<std::uint8_t> bytes(snapshot.begin(), snapshot.begin() + static_cast<std::ptrdiff_t>(prefix_size));
+		WritePlan(bytes, plan);
+		bytes.insert(bytes.end(), snapshot.end() - static_cast<std::ptrdiff_t>(rng_bytes), snapshot.end());
+
+		return bytes;
+	}
+
+	// Steps both games with the first one's autopilot until it ends or runs out of steps, and compares every
+	// decision and the final state.
+	bool PlaysOnIdentically(Simulation& original, Simulation& restored, int steps)
+	{
+		for (int step = 0; step < steps && !original.GameOver(); ++step)
+		{
+			const Direction direction = original.AutopilotDirection();
+
+			if (restored.AutopilotDirection() != direction)
+			{
+				return false;
+			}
+
+			original.Step(direction);
+			restored.Step(direction);
+		}
+
+		std::vector<std::uint8_t> original_bytes;
+		std::vector<std::uint8_t> restored_bytes;
+		original.Snapshot(original_bytes);
+		restored.Snapshot(restored_bytes);
+
+		return original_bytes == restored_bytes;
+	}
+
+	// A rejected snapshot must leave the game as it was; an accepted one must hold a playable game.
+	bool RestoresSafely(const std::vector<std::uint8_t>& bytes, int columns, int rows, bool& accepted)
+	{
+		Simulation simulation(columns, rows, 7);
+		std::vector<std::uint8_t> before;
+		std::vector<std::uint8_t> after;
+		simulation.Snapshot(before);
+
+		accepted = simulation.Restore(bytes.data(), bytes.size());
+
+		if (!accepted)
+		{
+			simulation.Snapshot(after);
+			return before == after;
+		}
+
+		if (simulation.Food() != -1 && simulation.IsOccupied(simulation.Food()))
+		{
+			return false;
+		}
+
+		// A broken state that slipped through would trip the core's asserts here.
+		for (int step = 0; step < 200 && !simulation.GameOver(); ++step)
+		{
+			simulation.Step(simulation.AutopilotDirection());
+		}
+
+		return true;
+	}
+} // namespace
+
+// Checks snapshots of autopilot games: a restored game must play on exactly like the original, both from right
+// after a step and from between an autopilot decision and its step. Snapshots with stale or broken plans and
+// truncated ones must be rejected, and ones with a bit flipped must be rejected or restore to a playable game.
+// Exits with 1 on any failure.
+int main(int argc, char* argv[])
+{
+	int columns = 24;
+	int rows = 18;
+	int games = 20;
+	std::uint64_t seed = 1;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--columns") == 0 && i + 1 < argc)
+		{
+			columns = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--rows") == 0 && i + 1 < argc)
+		{
+			rows = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--games") == 0 && i + 1 < argc)
+		{
+			games = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+		{
+			seed = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else
+		{
+			PrintUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (columns < 2 || rows < 2 || games < 1)
+	{
+		PrintUsage(argv[0]);
+		return 1;
+	}
+
+	const AutopilotMode modes[] = { AutopilotMode::A_STAR, AutopilotMode::HAMILTONIAN, AutopilotMode::DISTANCE_FIELD, AutopilotMode::MONTE_CARLO };
+	int failures = 0;
+	int round_trips = 0;
+	int plan_cases = 0;
+	int flips_accepted = 0;
+	int flips_rejected = 0;
+
+	for (int game = 0; game < games; ++game)
+	{
+		// Plays the same game up to the checkpoint in every simulation it is given.
+		auto play_to_checkpoint = [&](Simulation& simulation)
+		{
+			simulation.SetAutopilotMode(modes[game % 4]);
+			simulation.SetAutopilotWrapped(game % 8 >= 4);
+
+			for (int step = 50 + game * 211 % 2000; step > 0 && !simulation.GameOver(); --step)
+			{
+				simulation.Step(simulation.AutopilotDirection());
+			}
+		};
+
+		const std::uint64_t game_seed = seed + static_cast<std::uint64_t>(game);
+		Simulation original(columns, rows, game_seed);
+		Simulation replayed(columns, rows, game_seed);
+		play_to_checkpoint(original);
+		play_to_checkpoint(replayed);
+
+		if (original.GameOver())
+		{
+			continue;
+		}
+
+		// Right after a step, between the next autopilot decision and its step, when the plan already starts a
+		// cell ahead, and right after that step.
+		std::vector<std::uint8_t> stepped;
+		std::vector<std::uint8_t> decided;
+		std::vector<std::uint8_t> after_step;
+		const std::vector<int> stale_plan = original.ShortestPathCells();
+		original.Snapshot(stepped);
+		const Direction direction = original.AutopilotDirection();
+		original.Snapshot(decided);
+		original.Step(direction);
+		original.Snapshot(after_step);
+		replayed.Step(replayed.AutopilotDirection());
+
+		const std::vector<int> plan = original.ShortestPathCells();
+		const int neck = original.GetSnake().Length() >= 2 ? original.GetSnake().Segment(1) : -1;
+
+		Simulation from_stepped(columns, rows, 1000);
+		Simulation from_decided(columns, rows, 2000);
+
+		if (!from_stepped.Restore(stepped.data(), stepped.size()) || !from_decided.Restore(decided.data(), decided.size()))
+		{
+			printf("game %d: a snapshot was not restored\n", game);
+			++failures;
+		}
+		else
+		{
+			from_stepped.Step(from_stepped.AutopilotDirection());
+			from_decided.Step(direction);
+
+			if (!PlaysOnIdentically(original, from_stepped, 5000) || !PlaysOnIdentically(replayed, from_decided, 5000))
+			{
+				printf("game %d: a restored game played on differently\n", game);
+				++failures;
+			}
+
+			round_trips += 2;
+		}
+
+		// Plans that no longer lead from the head to the food over free cells.
+		std::vector<std::vector<int>> broken_plans;
+
+		if (!stale_plan.empty())
+		{
+			// The plan from one step back, whose next cell is now the head.
+			broken_plans.push_back(stale_plan);
+		}
+
+		if (plan.size() >= 2)
+		{
+			// The plan without its next cell, so that it starts two cells away from the head.
+			broken_plans.push_back(std::vector<int>(plan.begin(), plan.end() - 1));
+		}
+
+		if (!plan.empty() && neck != -1)
+		{
+			// The plan stepping onto the neck first.
+			broken_plans.push_back(plan);
+			broken_plans.back().push_back(neck);
+		}
+
+		Simulation target(columns, rows, 1);
+		const std::vector<std::uint8_t> spliced = WithPlan(after_step, plan, plan);
+
+		if (!target.Restore(spliced.data(), spliced.size()))
+		{
+			printf("game %d: the snapshot with its own plan spliced back in was not restored\n", game);
+			++failures;
+		}
+
+		for (const std::vector<int>& broken_plan : broken_plans)
+		{
+			const std::vector<std::uint8_t> bytes = WithPlan(after_step, plan, broken_plan);
+
+			if (target.Restore(bytes.data(), bytes.size()))
+			{
+				printf("game %d: a snapshot with a broken plan of %zu cells was restored\n", game, broken_plan.size());
+				++failures;
+			}
+
+			++plan_cases;
+		}
+
+		for (std::size_t size = 0; size < after_step.size(); ++size)
+		{
+			if (target.Restore(after_step.data(), size))
+			{
+				printf("game %d: a snapshot cut to %zu of %zu bytes was restored\n", game, size, after_step.size());
+				++failures;
+			}
+		}
+
+		// Every bit but the RNG words, whose every value is a valid state.
+		for (std::size_t bit = 0; bit < (after_step.size() - rng_bytes) * 8; ++bit)
+		{
+			std::vector<std::uint8_t> bytes = after_step;
+			bytes[bit / 8] ^= static_cast<std::uint8_t>(1 << (bit % 8));
+			bool accepted = false;
+
+			if (!RestoresSafely(bytes, columns, rows, accepted))
+			{
+				printf("game %d: flipping bit %zu left a bad game\n", game, bit);
+				++failures;
+			}
+
+			if (accepted)
+			{
+				++flips_accepted;
+			}
+			else
+			{
+				++flips_rejected;
+			}
+		}
+	}
+
+	printf("games=%d round_trips=%d broken_plans=%d flips_accepted=%d flips_rejected=%d failures=%d\n", games, round_trips, plan_cases, flips_accepted, flips_rejected, failures);
+
+	return failures == 0 ? 0 : 1;
+}
\ No newline at end of file